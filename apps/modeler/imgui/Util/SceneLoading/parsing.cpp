@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -81,13 +82,20 @@ int addEntity(Engine::Registry &registry,
 
     if (node.find("children") != node.end())
     {
+        std::vector<unsigned int> children{};
+        children.reserve(node["children"].size());
         for (auto &child : node["children"])
         {
             unsigned int childNodeIndex = child.get<unsigned int>();
-            int childIndex = addEntity(registry, path, j, j["nodes"][childNodeIndex], meshData, textureIndex);
-            auto childHierarchy = registry.createComponent<Engine::HierarchyComponent>(childIndex);
-            childHierarchy->setParent(entityIndex);
-            registry.updated<Engine::HierarchyComponent>(childIndex);
+            children.push_back(addEntity(registry, path, j, j["nodes"][childNodeIndex], meshData, textureIndex));
+        }
+
+        // the hierarchies of all children are created at once
+        auto childHierarchies = registry.createComponents<Engine::HierarchyComponent>(children);
+        for (int i{0}; i < children.size(); ++i)
+        {
+            childHierarchies[i]->setParent(entityIndex);
+            registry.updated<Engine::HierarchyComponent>(children[i]);
         }
     }
 
@@ -96,6 +104,24 @@ int addEntity(Engine::Registry &registry,
         auto mesh = j["meshes"].at(node["mesh"].get<int>());
         int count = 0;
 
+        // meshes with multiple primitives get a child entity for every primitive
+        std::vector<unsigned int> primitiveEntities{};
+        if (mesh["primitives"].size() > 1)
+        {
+            primitiveEntities = registry.addEntities(mesh["primitives"].size());
+            for (int i{0}; i < primitiveEntities.size(); ++i)
+            {
+                registry.createComponent<Engine::TagComponent>(primitiveEntities[i], "Primitive " + std::to_string(i));
+            }
+
+            auto hierarchies = registry.createComponents<Engine::HierarchyComponent>(primitiveEntities);
+            for (int i{0}; i < primitiveEntities.size(); ++i)
+            {
+                hierarchies[i]->setParent(entityIndex);
+                registry.updated<Engine::HierarchyComponent>(primitiveEntities[i]);
+            }
+        }
+
         for (auto &primitive : mesh["primitives"])
         {
             int primitiveEntity;
@@ -106,12 +132,7 @@ int addEntity(Engine::Registry &registry,
             }
             else
             {
-                std::string name{"Primitive " + std::to_string(count++)};
-                primitiveEntity = registry.addEntity();
-                registry.createComponent<Engine::TagComponent>(primitiveEntity, name);
-                auto hierarchy{registry.createComponent<Engine::HierarchyComponent>(primitiveEntity)};
-                hierarchy->setParent(entityIndex);
-                registry.updated<Engine::HierarchyComponent>(primitiveEntity);
+                primitiveEntity = primitiveEntities[count++];
             }
 
             if (primitive.find("material") != primitive.end())
@@ -29,7 +29,7 @@ void UICreation::CameraComponentWindow::main() {
     }
     auto isUsed = m_registry.hasComponent<Engine::ActiveCameraComponent>(m_currentEntity);
     if (ImGui::Checkbox("Use Camera", &isUsed) && isUsed) {
-        unsigned int activeCameraEntity = m_registry.getOwners<Engine::ActiveCameraComponent>()[0].front();
+        unsigned int activeCameraEntity = m_registry.getEntities<Engine::ActiveCameraComponent>().front();
         auto oldCamera = m_registry.getComponent<Engine::CameraComponent>(activeCameraEntity);
         m_component->setAspect(oldCamera->getAspect());
         m_component->calculateProjection();
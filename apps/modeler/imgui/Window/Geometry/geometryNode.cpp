@@ -1,5 +1,6 @@
 #include "geometryNode.h"
 #include "../helpers.h"
+#include <algorithm>
 #include <Components/Render/render.h>
 #include <Core/Components/Geometry/geometry.h>
 #include <OpenGL/Components/OpenGLGeometry/openGLGeometry.h>
@@ -28,14 +29,16 @@ void UICreation::GeometryComponentWindow::main()
 
     if (ImGui::TreeNode("Vertices"))
     {
-        std::vector<Engine::Point3> &vertices{m_component->getVertices()};
-        for (int i = 0; i < vertices.size(); ++i)
+        for (int i = 0; i < m_component->getVertices().size(); ++i)
         {
             std::string str = std::to_string(i);
             str.insert(0, "Vertex ");
-            ImGui::DragFloat3(str.c_str(), vertices[i].data(), 0.1);
+            // edited on a copy since the geometry might be shared with other entities
+            Engine::Point3 vertex{m_component->getVertices()[i]};
+            ImGui::DragFloat3(str.c_str(), vertex.data(), 0.1);
             if (ImGui::IsItemEdited())
             {
+                uniqueComponent()->getVertices()[i] = vertex;
                 m_registry.updated<Engine::GeometryComponent>(m_selectedEntity);
             }
         }
@@ -50,7 +53,7 @@ void UICreation::GeometryComponentWindow::main()
             ImGui::SameLine();
             if (ImGui::Button("+##add_vertex"))
             {
-                m_component->addVertex(Engine::Point3{newVertex});
+                uniqueComponent()->addVertex(Engine::Point3{newVertex});
                 m_registry.updated<Engine::GeometryComponent>(m_selectedEntity);
                 newVertex = Engine::Point3{0.0f, 0.0f, 0.0f};
             }
@@ -61,14 +64,16 @@ void UICreation::GeometryComponentWindow::main()
     }
     if (ImGui::TreeNode("Faces"))
     {
-        std::vector<unsigned int> &faces{m_component->getFaces()};
-        for (int i = 0; i < faces.size(); i += 3)
+        for (int i = 0; i < m_component->getFaces().size(); i += 3)
         {
             std::string str = std::to_string(i / 3);
             str.insert(0, "Face ");
-            ImGui::InputScalarN(str.c_str(), ImGuiDataType_U32, faces.data() + i, 3);
+            unsigned int *face{m_component->getFaces().data() + i};
+            unsigned int indices[3]{face[0], face[1], face[2]};
+            ImGui::InputScalarN(str.c_str(), ImGuiDataType_U32, indices, 3);
             if (ImGui::IsItemEdited())
             {
+                std::copy(indices, indices + 3, uniqueComponent()->getFaces().begin() + i);
                 m_registry.updated<Engine::GeometryComponent>(m_selectedEntity);
             }
         }
@@ -83,7 +88,7 @@ void UICreation::GeometryComponentWindow::main()
             ImGui::SameLine();
             if (ImGui::Button("+##add_face"))
             {
-                m_component->addFace(newFace[0], newFace[1], newFace[2]);
+                uniqueComponent()->addFace(newFace[0], newFace[1], newFace[2]);
                 m_registry.updated<Engine::GeometryComponent>(m_selectedEntity);
                 newFace[0] = 0u;
                 newFace[1] = 0u;
@@ -96,12 +101,12 @@ void UICreation::GeometryComponentWindow::main()
     }
     if (ImGui::Button("Calculate Normals"))
     {
-        m_component->calculateNormals();
+        uniqueComponent()->calculateNormals();
         m_registry.updated<Engine::GeometryComponent>(m_selectedEntity);
     }
     if (ImGui::Button("Invert Normals"))
     {
-        for (Engine::Vector3 &normal : m_component->getNormals())
+        for (Engine::Vector3 &normal : uniqueComponent()->getNormals())
         {
             normal = -normal;
         }
@@ -111,13 +116,14 @@ void UICreation::GeometryComponentWindow::main()
     if (ImGui::Button("Center on origin"))
     {
         Engine::Vector3 avg{0.0, 0.0, 0.0};
-        for (const auto &vert : m_component->getVertices())
+        std::vector<Engine::Point3> &vertices{uniqueComponent()->getVertices()};
+        for (const auto &vert : vertices)
         {
             avg += vert - Engine::Point3{0, 0, 0};
         }
-        avg /= m_component->getVertices().size();
+        avg /= vertices.size();
 
-        for (auto &vert : m_component->getVertices())
+        for (auto &vert : vertices)
         {
             vert -= avg;
         }
@@ -136,6 +142,6 @@ void UICreation::GeometryComponentWindow::main()
 
     if (ImGui::Button("Calculate Bounding Box"))
     {
-        m_component->calculateBoundingBox();
+        uniqueComponent()->calculateBoundingBox();
     }
 }
\ No newline at end of file
@@ -36,7 +36,7 @@ UICreation::MainViewPort::MainViewPort(Engine::Registry &registry,
     registry.updated<Engine::CameraComponent>(m_cameraEntity);
 
     m_cameraChangeCallback = registry.onAdded<Engine::ActiveCameraComponent>(
-        [this, &registry](unsigned int entity, std::weak_ptr<Engine::ActiveCameraComponent> aC)
+        [this, &registry](unsigned int entity, Engine::ActiveCameraComponent *aC)
         {
             this->m_cameraEntity = entity;
             this->m_camera = registry.getComponent<Engine::CameraComponent>(entity);
@@ -72,12 +72,6 @@ UICreation::MainViewPort::MainViewPort(Engine::Registry &registry,
 
 void UICreation::MainViewPort::main()
 {
-    // render the scene into a separate frame buffer
-    m_framebuffer.clear();
-    m_framebuffer.bind();
-    m_renderer.render(m_renderables);
-    m_framebuffer.unbind();
-
     if (ImGui::GetIO().InputQueueCharacters.size() && m_selectedEntity > -1)
     {
         onKeyPress(ImGui::GetIO().InputQueueCharacters[0]);
@@ -145,6 +139,16 @@ void UICreation::MainViewPort::main()
         ImGui::EndDragDropSource();
     }
 
+    // the updates of the frame (component windows and the input above) reach the trackers once right before drawing
+    m_registry.flushUpdates();
+
+    // render the scene into a separate frame buffer
+    m_framebuffer.clear();
+    m_framebuffer.bind();
+    m_renderTracker.update();
+    m_renderer.render(m_renderables);
+    m_framebuffer.unbind();
+
     m_postProcesser.postProcess(m_framebuffer.getTexture());
 
     ImGui::GetWindowDrawList()->AddImage((void *)m_postProcesser.getFramebuffer().getTexture(),
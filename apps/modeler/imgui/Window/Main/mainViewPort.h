@@ -3,6 +3,7 @@
 
 #include "../Templates/imguiWindow.h"
 #include "postProcesser.h"
+#include <Core/ECS/signal.h>
 #include <Core/Math/math.h>
 #include <OpenGL/Framebuffer/framebuffer.h>
 #include <OpenGL/Systems/RenderTracker/renderTracker.h>
@@ -53,11 +54,10 @@ private:
     unsigned int m_cameraEntity{0};
     std::shared_ptr<Engine::CameraComponent> m_camera{};
     std::shared_ptr<Engine::TransformComponent> m_cameraTransform{};
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::ActiveCameraComponent>)>>
-        m_cameraChangeCallback;
+    Engine::Connection m_cameraChangeCallback;
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::TransformComponent>)>> m_addTransformCB;
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::TransformComponent>)>> m_removeTransformCB;
+    Engine::Connection m_addTransformCB;
+    Engine::Connection m_removeTransformCB;
 
     virtual void main();
     virtual void onResize();
@@ -8,6 +8,7 @@
 #include <OpenGL/Components/Texture/texture.h>
 #include <OpenGL/Util/textureIndex.h>
 #include <Raytracing/Components/Material/raytracingMaterial.h>
+#include <algorithm>
 #include <filesystem>
 #include <glad/glad.h>
 
@@ -94,33 +95,37 @@ void UICreation::MaterialComponentWindow::main()
                 unsigned int type{std::get<1>(materialData)};
                 int offset{std::get<2>(materialData)};
 
+                int size{type == GL_FLOAT ? 1 : type == GL_FLOAT_VEC3 ? 3 : type == GL_FLOAT_VEC4 ? 4 : 0};
+                if (size == 0)
+                {
+                    continue;
+                }
+
+                // edited on a copy since the material might be shared with other entities
+                float values[4]{};
+                float *property{material->getProperty<float>(offset)};
+                std::copy(property, property + size, values);
+
                 switch (type)
                 {
                 case GL_FLOAT:
-                    ImGui::DragFloat(name, material->getProperty<float>(offset));
-                    if (ImGui::IsItemEdited())
-                    {
-                        material->update();
-                        m_registry.updated<Engine::OpenGLMaterialComponent>(selectedEntity);
-                    }
+                    ImGui::DragFloat(name, values);
                     break;
                 case GL_FLOAT_VEC4:
-                    ImGui::ColorEdit4(name, material->getProperty<float>(offset));
-                    if (ImGui::IsItemEdited())
-                    {
-                        material->update();
-                        m_registry.updated<Engine::OpenGLMaterialComponent>(selectedEntity);
-                    }
+                    ImGui::ColorEdit4(name, values);
                     break;
                 case GL_FLOAT_VEC3:
-                    ImGui::ColorEdit3(name, material->getProperty<float>(offset));
-                    if (ImGui::IsItemEdited())
-                    {
-                        material->update();
-                        m_registry.updated<Engine::OpenGLMaterialComponent>(selectedEntity);
-                    }
+                    ImGui::ColorEdit3(name, values);
                     break;
                 }
+
+                if (ImGui::IsItemEdited())
+                {
+                    auto unique{m_registry.getUniqueComponent<Engine::OpenGLMaterialComponent>(m_currentEntity)};
+                    std::copy(values, values + size, unique->getProperty<float>(offset));
+                    unique->update();
+                    m_registry.updated<Engine::OpenGLMaterialComponent>(selectedEntity);
+                }
             }
         }
 
@@ -146,7 +151,8 @@ void UICreation::MaterialComponentWindow::main()
                         [](const fs::path &path) { return (fs::is_regular_file(path) && isImage(path)); }))
                 {
                     auto test = m_textureIndex.needTexture(*path, GL_TEXTURE_2D);
-                    texture->editTexture(index, test);
+                    m_registry.getUniqueComponent<Engine::OpenGLTextureComponent>(m_currentEntity)
+                        ->editTexture(index, test);
                 }
 
                 ++index;
@@ -166,7 +172,8 @@ void UICreation::MaterialComponentWindow::main()
                     if (createImGuiHighlightedDropTarget<fs::path>("system_path_payload",
                                                                    [](const fs::path &path) { return true; }))
                     {
-                        texture->addTexture(m_textureIndex.needTexture(*path, GL_TEXTURE_2D));
+                        m_registry.getUniqueComponent<Engine::OpenGLTextureComponent>(m_currentEntity)
+                            ->addTexture(m_textureIndex.needTexture(*path, GL_TEXTURE_2D));
                     }
                 }
             }
@@ -183,18 +190,24 @@ void UICreation::MaterialComponentWindow::main()
             m_registry.removeComponent<Engine::RaytracingMaterial>(m_currentEntity);
         }
 
-        ImGui::ColorEdit4("Color##Raytrace", raytracingMaterial->getColor().data());
+        Engine::Vector4 color{raytracingMaterial->getColor()};
+        ImGui::ColorEdit4("Color##Raytrace", color.data());
+        if (ImGui::IsItemEdited())
+        {
+            m_registry.getUniqueComponent<Engine::RaytracingMaterial>(m_selectedEntity)->setColor(color);
+        }
         bool isReflective = raytracingMaterial->isReflective();
         ImGui::Checkbox("Reflective##Raytrace", &isReflective);
         if (ImGui::IsItemClicked(0))
         {
+            auto unique{m_registry.getUniqueComponent<Engine::RaytracingMaterial>(m_selectedEntity)};
             if (!isReflective)
             {
-                raytracingMaterial->makeReflective();
+                unique->makeReflective();
             }
             else
             {
-                raytracingMaterial->makeUnreflective();
+                unique->makeUnreflective();
             }
         }
         ImGui::Separator();
@@ -156,7 +156,7 @@ void UICreation::OpenGLShaderCodeWindow::main()
     {
         try
         {
-            m_component->updateShaders(m_shaders);
+            uniqueComponent()->updateShaders(m_shaders);
             m_registry.updated<Engine::OpenGLShaderComponent>(m_currentEntity);
         }
         catch (Engine::ShaderException &err)
@@ -0,0 +1,55 @@
+#include "statsWindow.h"
+
+#include <imgui.h>
+
+UICreation::StatsWindow::StatsWindow(Engine::Registry &registry) : ImGuiWindow{"Registry Stats"}, m_registry{registry}
+{
+}
+
+void UICreation::StatsWindow::main()
+{
+    // the event counters are collected for about a second and shown as rates
+    double time{ImGui::GetTime()};
+    if (time - m_lastReset >= 1.0)
+    {
+        m_stats = m_registry.stats(true);
+        m_interval = time - m_lastReset;
+        m_lastReset = time;
+    }
+
+    ImGui::Text("Entities: %zu (ids handed out: %zu)", m_stats.numEntities, m_stats.maxEntities);
+    ImGui::Text("Queued updates: %zu", m_stats.numQueuedUpdates);
+    ImGui::Separator();
+
+    ImGui::Columns(9, "tableStats");
+    for (const char *header : {"Type", "Components", "Owners", "Sparse", "Callbacks", "Memory (KiB)", "Added/s",
+                               "Removed/s", "Updated/s"})
+    {
+        ImGui::Text("%s", header);
+        ImGui::NextColumn();
+    }
+    ImGui::Separator();
+
+    for (const Engine::ComponentTableStats &table : m_stats.tables)
+    {
+        ImGui::Text("%s", table.name.c_str());
+        ImGui::NextColumn();
+        ImGui::Text("%zu", table.numComponents);
+        ImGui::NextColumn();
+        ImGui::Text("%zu", table.numOwners);
+        ImGui::NextColumn();
+        ImGui::Text("%zu", table.sparseCapacity);
+        ImGui::NextColumn();
+        ImGui::Text("%zu", table.numCallbacks);
+        ImGui::NextColumn();
+        ImGui::Text("%.1f", table.memory / 1024.0);
+        ImGui::NextColumn();
+        ImGui::Text("%.1f", table.numAdded / m_interval);
+        ImGui::NextColumn();
+        ImGui::Text("%.1f", table.numRemoved / m_interval);
+        ImGui::NextColumn();
+        ImGui::Text("%.1f", table.numUpdated / m_interval);
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+}
\ No newline at end of file
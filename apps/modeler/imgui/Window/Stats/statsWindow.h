@@ -0,0 +1,30 @@
+#ifndef APPS_MODELER_IMGUI_WINDOW_STATS
+#define APPS_MODELER_IMGUI_WINDOW_STATS
+
+#include "../Templates/imguiWindow.h"
+#include <Core/ECS/registry.h>
+
+namespace UICreation
+{
+
+// shows how many components and callbacks each table of the registry holds and how often they change
+class StatsWindow : public ImGuiWindow
+{
+
+public:
+    StatsWindow() = delete;
+    StatsWindow(Engine::Registry &registry);
+
+private:
+    Engine::Registry &m_registry;
+    Engine::RegistryStats m_stats{};
+    // time of the last reset of the event counters and the time span the shown counters were collected over
+    double m_lastReset{0.0};
+    double m_interval{1.0};
+
+    virtual void main();
+};
+
+} // namespace UICreation
+
+#endif
\ No newline at end of file
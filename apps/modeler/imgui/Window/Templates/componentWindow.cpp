@@ -3,14 +3,21 @@
 UICreation::ComponentWindow::ComponentWindow(const std::string &name, int &currentEntity, Engine::Registry &registry) 
   : ImGuiWindow{name}, m_selectedEntity{currentEntity}, m_currentEntity{currentEntity}, m_registry{registry} 
 {
+  if (m_currentEntity > -1 && m_registry.isAlive(m_currentEntity)) {
+    m_currentHandle = m_registry.getHandle(m_currentEntity);
+  }
 }
 
 void UICreation::ComponentWindow::checkUpdates() {
   ImGuiWindow::checkUpdates();
 
-  if (m_currentEntity != m_selectedEntity) {
+  bool currentReplaced{m_currentEntity > -1 && !m_registry.isAlive(m_currentHandle)};
+  if (m_currentEntity != m_selectedEntity || currentReplaced) {
     int oldEntity = m_currentEntity;
     m_currentEntity = m_selectedEntity;
+    if (m_currentEntity > -1 && m_registry.isAlive(m_currentEntity)) {
+      m_currentHandle = m_registry.getHandle(m_currentEntity);
+    }
     onEntityChange(oldEntity);
   }
 }
@@ -18,6 +18,8 @@ public:
 protected:
     int &m_selectedEntity;
     int m_currentEntity{-1};
+    // detects that the current entity was removed and its id reused while the window wasn't rendered
+    Engine::EntityHandle m_currentHandle{0, 0};
     Engine::Registry &m_registry;
 
     // extends update checks by tracking the selected entity
@@ -74,6 +76,14 @@ protected:
     }
 
     virtual void onComponentChange(std::shared_ptr<CompType> oldComponent) {}
+
+    // the component for writing; a component shared with other entities (e.g. prefab instances) is copied first so
+    // the edit only affects the current entity (the window keeps showing the copy without a component change)
+    std::shared_ptr<CompType> uniqueComponent()
+    {
+        m_component = m_registry.getUniqueComponent<CompType>(m_currentEntity);
+        return m_component;
+    }
 };
 
 } // namespace UICreation
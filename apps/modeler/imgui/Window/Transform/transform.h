@@ -34,8 +34,7 @@ private:
 
     virtual void onComponentChange(std::shared_ptr<Engine::TransformComponent> oldComponent) override;
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::TransformComponent>)>>
-        m_transformChangeCallback;
+    Engine::Connection m_transformChangeCallback;
 };
 
 } // namespace UICreation
@@ -9,6 +9,7 @@
 #include "Window/Main/mainViewPort.h"
 #include "Window/OpenGLMaterial/openGLMaterial.h"
 #include "Window/Raytracing/raytracingWindow.h"
+#include "Window/Stats/statsWindow.h"
 #include "Window/Transform/transform.h"
 #include <Core/Components/Camera/camera.h>
 #include <Core/Components/Geometry/geometry.h>
@@ -40,6 +41,7 @@ UICreation::MainViewPort *mainViewport;
 UICreation::RaytracingViewport *raytracingViewport;
 
 UICreation::FileBrowser *fileBrowser;
+UICreation::StatsWindow *statsWindow;
 
 std::vector<UICreation::ComponentWindow *> componentWindows{};
 
@@ -84,6 +86,7 @@ void UI::init(Engine::Registry &registry,
     mainViewport = new UICreation::MainViewPort{registry, renderer, selectedEntity, textureIndex};
     raytracingViewport = new UICreation::RaytracingViewport{registry};
     fileBrowser = new UICreation::FileBrowser{registry, textureIndex};
+    statsWindow = new UICreation::StatsWindow{registry};
 
     componentWindows.emplace_back(new TransformComponentWindow{selectedEntity, registry});
     componentWindows.emplace_back(new CameraComponentWindow{selectedEntity, registry});
@@ -200,6 +203,9 @@ void drawShaderTypeSelection(Engine::Registry &registry)
 
 void UI::render(Engine::Registry &registry)
 {
+    // the component windows and the viewport input may update the same component many times per frame; the trackers
+    // only need to see the last state which the main viewport flushes right before drawing the scene
+    registry.deferUpdates();
 
     if (showDemoWindow)
     {
@@ -360,6 +366,10 @@ void UI::render(Engine::Registry &registry)
     // UIUtil::drawFileBrowser();
 
     fileBrowser->render();
+    statsWindow->render();
+
+    // nothing is left to flush unless the main viewport is hidden
+    registry.flushUpdates();
 
     ImGui::Render();
 }
@@ -0,0 +1,167 @@
+#include <Core/ECS/archetypeRegistry.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// the cases mirror the ones in registry.bench.cpp so both backends can be compared by name
+namespace
+{
+struct Position
+{
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+struct Velocity
+{
+    float x{1.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+// number of systems listening to updates in the fan-out benchmark
+constexpr unsigned int numListeners{4};
+
+std::vector<unsigned int> addEntities(Engine::ArchetypeRegistry &registry, unsigned int count)
+{
+    std::vector<unsigned int> entities{};
+    entities.reserve(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        entities.push_back(registry.addEntity());
+    }
+
+    return entities;
+}
+} // namespace
+
+static void BM_ArchetypeRegistry_addRemoveEntity(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ArchetypeRegistry registry{};
+
+    for (auto _ : state)
+    {
+        std::vector<unsigned int> entities = addEntities(registry, count);
+        for (unsigned int entity : entities)
+        {
+            registry.removeEntity(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ArchetypeRegistry_addRemoveEntity)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ArchetypeRegistry_addRemoveComponent(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ArchetypeRegistry registry{};
+    std::vector<unsigned int> entities = addEntities(registry, count);
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            registry.createComponent<Position>(entity);
+        }
+        for (unsigned int entity : entities)
+        {
+            registry.removeComponent<Position>(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ArchetypeRegistry_addRemoveComponent)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ArchetypeRegistry_getComponent(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ArchetypeRegistry registry{};
+    std::vector<unsigned int> entities = addEntities(registry, count);
+    for (unsigned int entity : entities)
+    {
+        registry.createComponent<Position>(entity);
+    }
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            benchmark::DoNotOptimize(registry.getComponent<Position>(entity).get());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ArchetypeRegistry_getComponent)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ArchetypeRegistry_updatedFanOut(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ArchetypeRegistry registry{};
+    std::vector<unsigned int> entities = addEntities(registry, count);
+    for (unsigned int entity : entities)
+    {
+        registry.createComponent<Position>(entity);
+    }
+
+    unsigned long long calls{0};
+    std::vector<Engine::Connection> listeners{};
+    for (unsigned int i = 0; i < numListeners; ++i)
+    {
+        listeners.push_back(registry.onUpdate<Position>(
+            [&calls](unsigned int, Engine::ArchetypeHandle<Position>) { ++calls; }));
+    }
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            registry.updated<Position>(entity);
+        }
+    }
+    benchmark::DoNotOptimize(calls);
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ArchetypeRegistry_updatedFanOut)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ArchetypeRegistry_view(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ArchetypeRegistry registry{};
+    std::vector<unsigned int> entities = addEntities(registry, count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        registry.createComponent<Position>(entities[i]);
+        if (i % 2 == 0)
+        {
+            registry.createComponent<Velocity>(entities[i]);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        registry.view<Position, Velocity>().each(
+            [](unsigned int, Position &position, Velocity &velocity)
+            {
+                position.x += velocity.x;
+                position.y += velocity.y;
+                position.z += velocity.z;
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ArchetypeRegistry_view)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <Core/ECS/componentTable.h>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Position
+{
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+// the ids of the entities spread over more than one page of the sparse arrays
+void fillTable(Engine::ComponentTable<Position> &table, unsigned int count)
+{
+    for (unsigned int entity = 0; entity < count; ++entity)
+    {
+        table.createComponent(entity);
+    }
+}
+} // namespace
+
+static void BM_ComponentTable_addRemove(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ComponentTable<Position> table{};
+
+    for (auto _ : state)
+    {
+        fillTable(table, count);
+        for (unsigned int entity = 0; entity < count; ++entity)
+        {
+            table.removeComponent(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ComponentTable_addRemove)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ComponentTable_getComponent(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::ComponentTable<Position> table{};
+    fillTable(table, count);
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity = 0; entity < count; ++entity)
+        {
+            benchmark::DoNotOptimize(table.getComponent(entity));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ComponentTable_getComponent)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <Core/ECS/registry.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct Position
+{
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+struct Velocity
+{
+    float x{1.0f};
+    float y{0.0f};
+    float z{0.0f};
+};
+
+struct Material
+{
+    float color[4]{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+// number of entities sharing one material in the grouping benchmark
+constexpr unsigned int groupSize{100};
+// number of systems listening to updates in the fan-out benchmark
+constexpr unsigned int numListeners{4};
+} // namespace
+
+static void BM_Registry_addRemoveEntity(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+
+    for (auto _ : state)
+    {
+        std::vector<unsigned int> entities = registry.addEntities(count);
+        for (unsigned int entity : entities)
+        {
+            registry.removeEntity(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_addRemoveEntity)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Registry_addRemoveComponent(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            registry.createComponent<Position>(entity);
+        }
+        for (unsigned int entity : entities)
+        {
+            registry.removeComponent<Position>(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_addRemoveComponent)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Registry_getComponent(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+    registry.createComponents<Position>(entities);
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            benchmark::DoNotOptimize(registry.getComponent<Position>(entity));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_getComponent)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+// every entity starts and stops sharing the same component which grows and shrinks a single owner list
+static void BM_Registry_sharedComponentChurn(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+    std::shared_ptr<Material> material = std::make_shared<Material>();
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            registry.addComponent<Material>(entity, material);
+        }
+        for (unsigned int entity : entities)
+        {
+            registry.removeComponent<Material>(entity);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_sharedComponentChurn)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Registry_updatedFanOut(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+    registry.createComponents<Position>(entities);
+
+    unsigned long long calls{0};
+    std::vector<Engine::Connection> listeners{};
+    for (unsigned int i = 0; i < numListeners; ++i)
+    {
+        listeners.push_back(
+            registry.onUpdate<Position>([&calls](unsigned int, std::weak_ptr<Position>) { ++calls; }));
+    }
+
+    for (auto _ : state)
+    {
+        for (unsigned int entity : entities)
+        {
+            registry.updated<Position>(entity);
+        }
+    }
+    benchmark::DoNotOptimize(calls);
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_updatedFanOut)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Registry_getGroupedComponents(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+    registry.createComponents<Position>(entities);
+
+    std::shared_ptr<Material> material{};
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (i % groupSize == 0)
+        {
+            material = registry.createComponent<Material>(entities[i]);
+        }
+        else
+        {
+            registry.addComponent<Material>(entities[i], material);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(registry.getGroupedComponents<Material, Position>());
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_getGroupedComponents)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+// same as BM_ArchetypeRegistry_view to compare both backends on a query over two component types
+static void BM_Registry_view(benchmark::State &state)
+{
+    unsigned int count = state.range(0);
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(count);
+    registry.createComponents<Position>(entities);
+    for (unsigned int i = 0; i < count; i += 2)
+    {
+        registry.createComponent<Velocity>(entities[i]);
+    }
+
+    for (auto _ : state)
+    {
+        registry.view<Position, Velocity>().each(
+            [](unsigned int, Position &position, Velocity &velocity)
+            {
+                position.x += velocity.x;
+                position.y += velocity.y;
+                position.z += velocity.z;
+            });
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Registry_view)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -8,6 +8,19 @@ Engine::CameraComponent::CameraComponent(Registry &registry) : m_registry{regist
 {
     calculateProjection();
 
+    associate();
+}
+
+Engine::CameraComponent::CameraComponent(const CameraComponent &other)
+    : m_projectionMatrix{other.m_projectionMatrix}, m_registry{other.m_registry}, m_entity{other.m_entity},
+      m_near{other.m_near}, m_far{other.m_far}, m_left{other.m_left}, m_right{other.m_right},
+      m_bottom{other.m_bottom}, m_top{other.m_top}, m_fov{other.m_fov}, m_aspect{other.m_aspect},
+      m_projection{other.m_projection}
+{
+}
+
+void Engine::CameraComponent::associate()
+{
     m_associateCallback = m_registry.onAdded<CameraComponent>(
         [=](unsigned int entity, std::weak_ptr<CameraComponent> camera)
         {
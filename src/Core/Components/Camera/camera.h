@@ -2,6 +2,7 @@
 #define CORE_COMPONENTS_CAMERA
 
 #include "../../Math/math.h"
+#include "../../ECS/signal.h"
 #include <functional>
 #include <memory>
 
@@ -25,7 +26,7 @@ class CameraComponent
 private:
     // waits for the component to be added to an entity to then set up callbacks
     // to react to changes in the Transform of that entity
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<CameraComponent>)>> m_associateCallback;
+    Connection m_associateCallback;
 
     Matrix4 m_projectionMatrix{};
     Registry &m_registry;
@@ -42,9 +43,13 @@ private:
 
     ProjectionType m_projection{ProjectionType::Perspective};
 
+    void associate();
+
 public:
     CameraComponent() = delete;
     CameraComponent(Registry &registry);
+    // copies don't register callbacks (the raytracer copies the camera on its worker threads)
+    CameraComponent(const CameraComponent &other);
 
     void updateAspect(float aspect);
     void calculateProjection();
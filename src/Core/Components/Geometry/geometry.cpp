@@ -2,6 +2,7 @@
 
 #include "../../../Util/fileHandling.h"
 #include <algorithm>
+#include <utility>
 
 namespace filesystem = std::filesystem;
 
@@ -20,6 +21,49 @@ Engine::GeometryComponent::GeometryComponent(std::vector<Point3> &&vertices,
     calculateBoundingBox();
 }
 
+Engine::GeometryComponent::GeometryComponent(const GeometryComponent &other)
+    : m_vertices{other.m_vertices}, m_normals{other.m_normals}, m_texCoords{other.m_texCoords}, m_faces{other.m_faces}
+{
+    calculateBoundingBox();
+}
+
+Engine::GeometryComponent::GeometryComponent(GeometryComponent &&other)
+    : m_vertices{std::move(other.m_vertices)}, m_normals{std::move(other.m_normals)},
+      m_texCoords{std::move(other.m_texCoords)}, m_faces{std::move(other.m_faces)}
+{
+    calculateBoundingBox();
+    other.calculateBoundingBox();
+}
+
+Engine::GeometryComponent &Engine::GeometryComponent::operator=(const GeometryComponent &other)
+{
+    if (&other != this)
+    {
+        m_vertices = other.m_vertices;
+        m_normals = other.m_normals;
+        m_texCoords = other.m_texCoords;
+        m_faces = other.m_faces;
+        calculateBoundingBox();
+    }
+
+    return *this;
+}
+
+Engine::GeometryComponent &Engine::GeometryComponent::operator=(GeometryComponent &&other)
+{
+    if (&other != this)
+    {
+        m_vertices = std::move(other.m_vertices);
+        m_normals = std::move(other.m_normals);
+        m_texCoords = std::move(other.m_texCoords);
+        m_faces = std::move(other.m_faces);
+        calculateBoundingBox();
+        other.calculateBoundingBox();
+    }
+
+    return *this;
+}
+
 std::vector<Engine::Point3> &Engine::GeometryComponent::getVertices() { return m_vertices; }
 const std::vector<Engine::Point3> &Engine::GeometryComponent::getVertices() const { return m_vertices; }
 
@@ -421,6 +465,8 @@ Engine::AccelerationStructure &Engine::AccelerationStructure::operator=(const Ac
     m_triangles = other.m_triangles;
     m_children = other.m_children;
     m_geometry = other.m_geometry;
+
+    return *this;
 }
 
 void Engine::AccelerationStructure::subdivide(std::vector<int> &vertexRef)
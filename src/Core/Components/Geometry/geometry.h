@@ -56,6 +56,11 @@ public:
     GeometryComponent(std::vector<Point3> &&vertices,
                       std::vector<Vector3> &&normals,
                       std::vector<unsigned int> &&faces);
+    // the acceleration structure points back at its geometry so a copy builds its own
+    GeometryComponent(const GeometryComponent &other);
+    GeometryComponent(GeometryComponent &&other);
+    GeometryComponent &operator=(const GeometryComponent &other);
+    GeometryComponent &operator=(GeometryComponent &&other);
     std::vector<Point3> &getVertices();
     const std::vector<Point3> &getVertices() const;
     std::vector<Vector3> &getNormals();
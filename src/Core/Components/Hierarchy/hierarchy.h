@@ -1,6 +1,7 @@
 #ifndef CORE_COMPONENTS_HIERARCHY
 #define CORE_COMPONENTS_HIERARCHY
 
+#include "../../ECS/snapshot.h"
 #include <vector>
 
 namespace Engine
@@ -30,6 +31,27 @@ private:
     std::vector<unsigned int> m_children;
 };
 
+template <>
+struct snapshot_traits<HierarchyComponent>
+{
+    static void write(SnapshotWriter &writer, HierarchyComponent &hierarchy)
+    {
+        writer.write(hierarchy.getParent());
+        writer.writeVector(hierarchy.getChildren());
+    }
+
+    static HierarchyComponent read(SnapshotReader &reader)
+    {
+        HierarchyComponent hierarchy{};
+        hierarchy.setParent(reader.read<int>());
+        for (unsigned int child : reader.readVector<unsigned int>())
+        {
+            hierarchy.addChild(child);
+        }
+        return hierarchy;
+    }
+};
+
 }; // namespace Engine
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef CORE_COMPONENTS_TAG
 #define CORE_COMPONENTS_TAG
 
+#include "../../ECS/snapshot.h"
 #include <string>
 
 namespace Engine
@@ -21,6 +22,14 @@ public:
     void set(const char *tag);
     void set(std::string &tag);
 };
+
+template <>
+struct snapshot_traits<TagComponent>
+{
+    static void write(SnapshotWriter &writer, TagComponent &tag) { writer.writeString(tag.get()); }
+
+    static TagComponent read(SnapshotReader &reader) { return TagComponent{reader.readString()}; }
+};
 } // namespace Engine
 
 #endif
\ No newline at end of file
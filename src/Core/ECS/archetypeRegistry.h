@@ -0,0 +1,601 @@
+#ifndef CORE_ECS_ARCHETYPEREGISTRY
+#define CORE_ECS_ARCHETYPEREGISTRY
+
+#include "signal.h"
+#include "util.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+namespace detail
+{
+// type erased array of all components of one type inside an archetype
+class ArchetypeColumn
+{
+public:
+    virtual ~ArchetypeColumn() {}
+    // empty column for the same component type
+    virtual std::unique_ptr<ArchetypeColumn> createEmpty() const = 0;
+    // appends the component in row to the other column (the moved from component stays in place until it is removed)
+    virtual void moveTo(unsigned int row, ArchetypeColumn &other) = 0;
+    // removes the component in row by moving the last component into its place
+    virtual void swapRemove(unsigned int row) = 0;
+};
+
+template <typename ComponentType>
+class TypedArchetypeColumn : public ArchetypeColumn
+{
+public:
+    std::vector<ComponentType> components{};
+
+    std::unique_ptr<ArchetypeColumn> createEmpty() const override
+    {
+        return std::make_unique<TypedArchetypeColumn<ComponentType>>();
+    }
+
+    void moveTo(unsigned int row, ArchetypeColumn &other) override
+    {
+        static_cast<TypedArchetypeColumn<ComponentType> &>(other).components.push_back(std::move(components[row]));
+    }
+
+    void swapRemove(unsigned int row) override
+    {
+        if (row != components.size() - 1)
+        {
+            components[row] = std::move(components.back());
+        }
+        components.pop_back();
+    }
+};
+
+// all entities with exactly the same set of component types; the components of every type are stored contiguously
+// and the components of one entity share the same row in every column
+struct Archetype
+{
+    // sorted type indices of the component types
+    std::vector<unsigned int> types{};
+    // one column per entry in types
+    std::vector<std::unique_ptr<ArchetypeColumn>> columns{};
+    // entity of each row
+    std::vector<unsigned int> entities{};
+    // archetypes reached by adding or removing a component type (filled on first use)
+    std::unordered_map<unsigned int, unsigned int> addEdges{};
+    std::unordered_map<unsigned int, unsigned int> removeEdges{};
+
+    // position of the type inside types or -1
+    int find(unsigned int type) const
+    {
+        auto position = std::lower_bound(types.begin(), types.end(), type);
+        return position != types.end() && *position == type ? position - types.begin() : -1;
+    }
+
+    template <typename ComponentType>
+    std::vector<ComponentType> &components()
+    {
+        return static_cast<TypedArchetypeColumn<ComponentType> &>(*columns[find(type_index<ComponentType>::value())])
+            .components;
+    }
+};
+} // namespace detail
+
+class ArchetypeRegistry;
+
+// refers to the component of an entity inside an ArchetypeRegistry; the component is looked up on every access so the
+// handle stays valid while the component moves between archetypes (mirrors shared_ptr and weak_ptr like
+// ComponentHandle so code written against Registry compiles with both)
+template <typename ComponentType>
+class ArchetypeHandle
+{
+private:
+    ArchetypeRegistry *m_registry{nullptr};
+    unsigned int m_entity{0};
+    unsigned int m_generation{0};
+
+public:
+    ArchetypeHandle() {}
+    ArchetypeHandle(std::nullptr_t) {}
+    ArchetypeHandle(ArchetypeRegistry *registry, unsigned int entity, unsigned int generation)
+        : m_registry{registry}, m_entity{entity}, m_generation{generation}
+    {
+    }
+
+    // nullptr once the entity was removed or doesn't own a component of the type anymore
+    ComponentType *get() const;
+
+    ComponentType *lock() const { return get(); }
+    bool expired() const { return get() == nullptr; }
+
+    ComponentType &operator*() const { return *get(); }
+    ComponentType *operator->() const { return get(); }
+
+    explicit operator bool() const { return get() != nullptr; }
+
+    bool operator==(const ArchetypeHandle &other) const { return get() == other.get(); }
+    bool operator!=(const ArchetypeHandle &other) const { return !(*this == other); }
+    bool operator==(std::nullptr_t) const { return get() == nullptr; }
+    bool operator!=(std::nullptr_t) const { return get() != nullptr; }
+};
+
+// alternative to Registry that groups entities by the set of component types they own (their archetype)
+// queries over several component types walk contiguous arrays instead of one sparse set per type; the price is that
+// components move whenever a component is added to or removed from their entity
+// code templated on the registry type works with both backends as long as it sticks to:
+//   addEntity, removeEntity, isAlive, clear
+//   createComponent, getComponent, hasComponent, removeComponent and updated (components are handed out as
+//   ArchetypeHandles which are dereferenced like the shared_ptrs of Registry)
+//   onAdded, onRemove, onUpdate and onComponentSwap (callbacks get the entity and a handle like the weak_ptr Registry
+//   passes, e.g. [](unsigned int entity, auto component) { use(*component.lock()); })
+//   each<ComponentType>(func(component)) and view<ComponentTypes...>().each(func(entity, components...))
+// components are stored by value so addComponent and shared components aren't supported
+class ArchetypeRegistry
+{
+public:
+    template <typename ComponentType>
+    using pointer = ArchetypeHandle<ComponentType>;
+
+    template <typename ComponentType>
+    using signal_type = Signal<void(unsigned int, ArchetypeHandle<ComponentType>)>;
+
+    // entities owning all of the given types (only offers each() to match Registry::view)
+    template <typename... ComponentTypes>
+    class View
+    {
+    private:
+        ArchetypeRegistry *m_registry;
+
+    public:
+        View(ArchetypeRegistry *registry) : m_registry{registry} {}
+
+        // calls func(entity, components...); func must not add or remove components or entities
+        template <typename Func>
+        void each(Func func) const
+        {
+            m_registry->eachEntity<ComponentTypes...>(func);
+        }
+    };
+
+private:
+    struct Location
+    {
+        // -1 for unused entities
+        int archetype;
+        unsigned int row;
+    };
+
+    template <typename ComponentType>
+    struct TypeSignals
+    {
+        signal_type<ComponentType> added{};
+        signal_type<ComponentType> remove{};
+        signal_type<ComponentType> update{};
+        signal_type<ComponentType> swap{};
+    };
+
+    std::vector<detail::Archetype> m_archetypes{};
+    std::map<std::vector<unsigned int>, unsigned int> m_archetypeIndices{};
+
+    std::vector<Location> m_locations{};
+    // increased every time an entity is removed to invalidate the handles to its components
+    std::vector<unsigned int> m_generations{};
+    // stack of unused entity ids (the last removed id is reused first)
+    std::vector<unsigned int> m_freeEntityIds{};
+    unsigned int m_numEntities{0};
+
+    // signals of each component type (TypeSignals<ComponentType>)
+    std::vector<std::shared_ptr<void>> m_signals{};
+    // invokes the remove callbacks of one component type for an entity
+    std::vector<std::function<void(unsigned int)>> m_removeNotifiers{};
+
+    template <typename ComponentType>
+    TypeSignals<ComponentType> &ensureSignals()
+    {
+        unsigned int type = type_index<ComponentType>::value();
+        if (type >= m_signals.size())
+        {
+            m_signals.resize(type + 1);
+            m_removeNotifiers.resize(type + 1, [](unsigned int foo) { (void)foo; });
+        }
+
+        if (!m_signals[type])
+        {
+            m_signals[type] = std::make_shared<TypeSignals<ComponentType>>();
+            m_removeNotifiers[type] = [this](unsigned int entity)
+            {
+                if (isAlive(entity) && find<ComponentType>(entity))
+                {
+                    ensureSignals<ComponentType>().remove(entity, handle<ComponentType>(entity));
+                }
+            };
+        }
+
+        return *static_cast<TypeSignals<ComponentType> *>(m_signals[type].get());
+    }
+
+    unsigned int ensureArchetype(std::vector<unsigned int> &&types,
+                                 std::vector<std::unique_ptr<detail::ArchetypeColumn>> &&columns)
+    {
+        auto existing = m_archetypeIndices.find(types);
+        if (existing != m_archetypeIndices.end())
+        {
+            return existing->second;
+        }
+
+        unsigned int index = m_archetypes.size();
+        m_archetypeIndices.emplace(types, index);
+        m_archetypes.emplace_back();
+        m_archetypes.back().types = std::move(types);
+        m_archetypes.back().columns = std::move(columns);
+
+        return index;
+    }
+
+    template <typename ComponentType>
+    unsigned int archetypeWith(unsigned int from)
+    {
+        unsigned int type = type_index<ComponentType>::value();
+
+        auto edge = m_archetypes[from].addEdges.find(type);
+        if (edge != m_archetypes[from].addEdges.end())
+        {
+            return edge->second;
+        }
+
+        std::vector<unsigned int> types{};
+        std::vector<std::unique_ptr<detail::ArchetypeColumn>> columns{};
+        bool inserted{false};
+        for (unsigned int i = 0; i <= m_archetypes[from].types.size(); ++i)
+        {
+            if (!inserted && (i == m_archetypes[from].types.size() || m_archetypes[from].types[i] > type))
+            {
+                types.push_back(type);
+                columns.push_back(std::make_unique<detail::TypedArchetypeColumn<ComponentType>>());
+                inserted = true;
+            }
+            if (i < m_archetypes[from].types.size())
+            {
+                types.push_back(m_archetypes[from].types[i]);
+                columns.push_back(m_archetypes[from].columns[i]->createEmpty());
+            }
+        }
+
+        unsigned int to = ensureArchetype(std::move(types), std::move(columns));
+        m_archetypes[from].addEdges[type] = to;
+        m_archetypes[to].removeEdges[type] = from;
+
+        return to;
+    }
+
+    unsigned int archetypeWithout(unsigned int from, unsigned int type)
+    {
+        auto edge = m_archetypes[from].removeEdges.find(type);
+        if (edge != m_archetypes[from].removeEdges.end())
+        {
+            return edge->second;
+        }
+
+        std::vector<unsigned int> types{};
+        std::vector<std::unique_ptr<detail::ArchetypeColumn>> columns{};
+        for (unsigned int i = 0; i < m_archetypes[from].types.size(); ++i)
+        {
+            if (m_archetypes[from].types[i] != type)
+            {
+                types.push_back(m_archetypes[from].types[i]);
+                columns.push_back(m_archetypes[from].columns[i]->createEmpty());
+            }
+        }
+
+        unsigned int to = ensureArchetype(std::move(types), std::move(columns));
+        m_archetypes[from].removeEdges[type] = to;
+        m_archetypes[to].addEdges[type] = from;
+
+        return to;
+    }
+
+    // removes the row of an entity from its archetype
+    void eraseRow(unsigned int entity)
+    {
+        detail::Archetype &archetype = m_archetypes[m_locations[entity].archetype];
+        unsigned int row = m_locations[entity].row;
+
+        for (std::unique_ptr<detail::ArchetypeColumn> &column : archetype.columns)
+        {
+            column->swapRemove(row);
+        }
+
+        unsigned int lastEntity = archetype.entities.back();
+        archetype.entities[row] = lastEntity;
+        m_locations[lastEntity].row = row;
+        archetype.entities.pop_back();
+    }
+
+    // moves the components an entity owns into another archetype (components the target doesn't have are dropped)
+    // the target columns the entity doesn't own a component for yet have to be filled by the caller
+    void moveEntity(unsigned int entity, unsigned int to)
+    {
+        detail::Archetype &source = m_archetypes[m_locations[entity].archetype];
+        detail::Archetype &target = m_archetypes[to];
+        unsigned int row = m_locations[entity].row;
+
+        for (unsigned int i = 0; i < source.types.size(); ++i)
+        {
+            int column = target.find(source.types[i]);
+            if (column != -1)
+            {
+                source.columns[i]->moveTo(row, *target.columns[column]);
+            }
+        }
+
+        eraseRow(entity);
+
+        m_locations[entity] = Location{static_cast<int>(to), static_cast<unsigned int>(target.entities.size())};
+        target.entities.push_back(entity);
+    }
+
+    void checkEntity(unsigned int entity) const
+    {
+        if (!isAlive(entity))
+        {
+            throw "EntityId out of bounds\n";
+        }
+    }
+
+    // the component of a living entity or nullptr
+    template <typename ComponentType>
+    ComponentType *find(unsigned int entity)
+    {
+        detail::Archetype &archetype = m_archetypes[m_locations[entity].archetype];
+        if (archetype.find(type_index<ComponentType>::value()) == -1)
+        {
+            return nullptr;
+        }
+
+        return &archetype.components<ComponentType>()[m_locations[entity].row];
+    }
+
+    template <typename ComponentType>
+    ArchetypeHandle<ComponentType> handle(unsigned int entity)
+    {
+        return ArchetypeHandle<ComponentType>{this, entity, m_generations[entity]};
+    }
+
+    // constructs with parentheses like the make_shared of Registry (braces would prefer initializer_list constructors)
+    template <typename ComponentType, typename... Args>
+    static ComponentType construct(Args &&...args)
+    {
+        if constexpr (sizeof...(Args) == 0)
+        {
+            return ComponentType{};
+        }
+        else
+        {
+            ComponentType component(std::forward<Args>(args)...);
+            return component;
+        }
+    }
+
+    template <typename... ComponentTypes, typename Func>
+    void eachEntity(Func func)
+    {
+        for (detail::Archetype &archetype : m_archetypes)
+        {
+            if (archetype.entities.empty() || ((archetype.find(type_index<ComponentTypes>::value()) == -1) || ...))
+            {
+                continue;
+            }
+
+            std::tuple<std::vector<ComponentTypes> *...> columns{&archetype.components<ComponentTypes>()...};
+            for (unsigned int row = 0; row < archetype.entities.size(); ++row)
+            {
+                func(archetype.entities[row], (*std::get<std::vector<ComponentTypes> *>(columns))[row]...);
+            }
+        }
+    }
+
+    template <typename ComponentType>
+    friend class ArchetypeHandle;
+
+public:
+    // the first archetype holds the entities without components
+    ArchetypeRegistry() { ensureArchetype(std::vector<unsigned int>{}, {}); }
+    ArchetypeRegistry(const ArchetypeRegistry &other) = delete;
+
+    unsigned int addEntity()
+    {
+        unsigned int entity;
+        if (!m_freeEntityIds.empty())
+        {
+            entity = m_freeEntityIds.back();
+            m_freeEntityIds.pop_back();
+        }
+        else
+        {
+            entity = m_locations.size();
+            m_locations.push_back(Location{-1, 0});
+            m_generations.push_back(0);
+        }
+
+        m_locations[entity] = Location{0, static_cast<unsigned int>(m_archetypes[0].entities.size())};
+        m_archetypes[0].entities.push_back(entity);
+        ++m_numEntities;
+
+        return entity;
+    }
+
+    bool isAlive(unsigned int entity) const
+    {
+        return entity < m_locations.size() && m_locations[entity].archetype != -1;
+    }
+
+    unsigned int getNumEntities() const { return m_numEntities; }
+
+    unsigned int getNumArchetypes() const { return m_archetypes.size(); }
+
+    // removing an unused entity does nothing
+    void removeEntity(unsigned int entity)
+    {
+        if (!isAlive(entity))
+        {
+            return;
+        }
+
+        // remove callbacks are called before the components are removed
+        std::vector<unsigned int> types = m_archetypes[m_locations[entity].archetype].types;
+        for (unsigned int type : types)
+        {
+            m_removeNotifiers[type](entity);
+        }
+
+        // one of the callbacks might have removed the entity
+        if (!isAlive(entity))
+        {
+            return;
+        }
+
+        eraseRow(entity);
+        m_locations[entity] = Location{-1, 0};
+        ++m_generations[entity];
+        m_freeEntityIds.push_back(entity);
+        --m_numEntities;
+    }
+
+    // creating a component for an entity that already owns one replaces the old component and invokes the swap
+    // callbacks instead of the add callbacks
+    template <typename ComponentType, typename... Args>
+    ArchetypeHandle<ComponentType> createComponent(unsigned int entity, Args &&...args)
+    {
+        checkEntity(entity);
+        TypeSignals<ComponentType> &signals = ensureSignals<ComponentType>();
+
+        if (ComponentType *component = find<ComponentType>(entity))
+        {
+            *component = construct<ComponentType>(std::forward<Args>(args)...);
+            signals.swap(entity, handle<ComponentType>(entity));
+            return handle<ComponentType>(entity);
+        }
+
+        unsigned int to = archetypeWith<ComponentType>(m_locations[entity].archetype);
+        // construct before moving so a throwing constructor leaves the entity untouched
+        ComponentType component{construct<ComponentType>(std::forward<Args>(args)...)};
+        moveEntity(entity, to);
+        m_archetypes[to].components<ComponentType>().push_back(std::move(component));
+
+        signals.added(entity, handle<ComponentType>(entity));
+
+        return handle<ComponentType>(entity);
+    }
+
+    template <typename ComponentType>
+    bool hasComponent(unsigned int entity) const
+    {
+        checkEntity(entity);
+
+        return m_archetypes[m_locations[entity].archetype].find(type_index<ComponentType>::value()) != -1;
+    }
+
+    // returns an empty handle if the entity doesn't own a component of the type
+    template <typename ComponentType>
+    ArchetypeHandle<ComponentType> getComponent(unsigned int entity)
+    {
+        checkEntity(entity);
+
+        return find<ComponentType>(entity) ? handle<ComponentType>(entity) : nullptr;
+    }
+
+    template <typename ComponentType>
+    void removeComponent(unsigned int entity)
+    {
+        checkEntity(entity);
+        if (!find<ComponentType>(entity))
+        {
+            return;
+        }
+
+        ensureSignals<ComponentType>().remove(entity, handle<ComponentType>(entity));
+
+        // the callbacks might have removed the component already
+        if (hasComponent<ComponentType>(entity))
+        {
+            moveEntity(entity, archetypeWithout(m_locations[entity].archetype, type_index<ComponentType>::value()));
+        }
+    }
+
+    // calls func(entity, components...) for every entity owning all of the given component types
+    // func must not add or remove components or entities
+    template <typename... ComponentTypes>
+    View<ComponentTypes...> view()
+    {
+        return View<ComponentTypes...>{this};
+    }
+
+    // visits every component of a specific type like Registry::each
+    template <typename ComponentType, typename Func>
+    void each(Func func)
+    {
+        eachEntity<ComponentType>([&func](unsigned int, ComponentType &component) { func(component); });
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onAdded(Func &&cb)
+    {
+        return ensureSignals<ComponentType>().added.connect(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onRemove(Func &&cb)
+    {
+        return ensureSignals<ComponentType>().remove.connect(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onUpdate(Func &&cb)
+    {
+        return ensureSignals<ComponentType>().update.connect(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onComponentSwap(Func &&cb)
+    {
+        return ensureSignals<ComponentType>().swap.connect(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType>
+    void updated(unsigned int entity)
+    {
+        checkEntity(entity);
+        if (find<ComponentType>(entity))
+        {
+            ensureSignals<ComponentType>().update(entity, handle<ComponentType>(entity));
+        }
+    }
+
+    void clear()
+    {
+        for (unsigned int entity = 0; entity < m_locations.size(); ++entity)
+        {
+            removeEntity(entity);
+        }
+    }
+};
+
+template <typename ComponentType>
+ComponentType *ArchetypeHandle<ComponentType>::get() const
+{
+    if (!m_registry || !m_registry->isAlive(m_entity) || m_registry->m_generations[m_entity] != m_generation)
+    {
+        return nullptr;
+    }
+
+    return m_registry->find<ComponentType>(m_entity);
+}
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef CORE_ECS_COMMANDBUFFER
+#define CORE_ECS_COMMANDBUFFER
+
+#include "registry.h"
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+// entity that is created when the command buffer that recorded it is submitted
+struct PendingEntity
+{
+    unsigned int index;
+};
+
+// target of a recorded command (an existing entity or one that is created by the buffer)
+class EntityRef
+{
+private:
+    unsigned int m_value;
+    bool m_pending;
+
+public:
+    EntityRef(unsigned int entity) : m_value{entity}, m_pending{false} {}
+    EntityRef(PendingEntity entity) : m_value{entity.index}, m_pending{true} {}
+
+    unsigned int resolve(const std::vector<unsigned int> &created) const
+    {
+        return m_pending ? created.at(m_value) : m_value;
+    }
+};
+
+// records structural changes to a registry so they can be made later on the thread that owns the registry
+// recording doesn't touch the registry; every thread records into its own buffer and the buffers are submitted at a
+// sync point
+class CommandBuffer
+{
+private:
+    using command = std::function<void(Registry &, std::vector<unsigned int> &)>;
+
+    std::vector<command> m_commands{};
+    unsigned int m_numPending{0};
+
+public:
+    CommandBuffer() {}
+
+    PendingEntity addEntity()
+    {
+        m_commands.push_back([](Registry &registry, std::vector<unsigned int> &created)
+                             { created.push_back(registry.addEntity()); });
+
+        return PendingEntity{m_numPending++};
+    }
+
+    void removeEntity(EntityRef entity)
+    {
+        m_commands.push_back([entity](Registry &registry, std::vector<unsigned int> &created)
+                             { registry.removeEntity(entity.resolve(created)); });
+    }
+
+    // the arguments are copied until the component is created
+    template <typename ComponentType, typename... Args>
+    void createComponent(EntityRef entity, Args &&...args)
+    {
+        m_commands.push_back(
+            [entity, arguments = std::make_tuple(std::forward<Args>(args)...)](
+                Registry &registry, std::vector<unsigned int> &created)
+            {
+                std::apply([&](const auto &...unpacked)
+                           { registry.createComponent<ComponentType>(entity.resolve(created), unpacked...); },
+                           arguments);
+            });
+    }
+
+    template <typename ComponentType>
+    void addComponent(EntityRef entity, component_pointer<ComponentType> component)
+    {
+        m_commands.push_back([entity, component](Registry &registry, std::vector<unsigned int> &created)
+                             { registry.addComponent<ComponentType>(entity.resolve(created), component); });
+    }
+
+    // lets the second entity share the component of the first one (both may be created by the buffer)
+    // nothing is shared if the first entity doesn't own the component anymore when the buffer is submitted
+    template <typename ComponentType>
+    void shareComponent(EntityRef from, EntityRef to)
+    {
+        m_commands.push_back(
+            [from, to](Registry &registry, std::vector<unsigned int> &created)
+            {
+                if (auto component = registry.getComponent<ComponentType>(from.resolve(created)))
+                {
+                    registry.addComponent<ComponentType>(to.resolve(created), component);
+                }
+            });
+    }
+
+    template <typename ComponentType>
+    void removeComponent(EntityRef entity)
+    {
+        m_commands.push_back([entity](Registry &registry, std::vector<unsigned int> &created)
+                             { registry.removeComponent<ComponentType>(entity.resolve(created)); });
+    }
+
+    template <typename ComponentType>
+    void updated(EntityRef entity)
+    {
+        m_commands.push_back([entity](Registry &registry, std::vector<unsigned int> &created)
+                             { registry.updated<ComponentType>(entity.resolve(created)); });
+    }
+
+    bool empty() const { return m_commands.empty(); }
+
+    unsigned int size() const { return m_commands.size(); }
+
+    // replays the commands in the order they were recorded and clears the buffer
+    // returns the created entities (the pending entity with index i is the i-th entity)
+    std::vector<unsigned int> submit(Registry &registry)
+    {
+        std::vector<command> commands{};
+        commands.swap(m_commands);
+        std::vector<unsigned int> created{};
+        created.reserve(m_numPending);
+        m_numPending = 0;
+
+        for (command &recorded : commands)
+        {
+            recorded(registry, created);
+        }
+
+        return created;
+    }
+
+    void clear()
+    {
+        m_commands.clear();
+        m_numPending = 0;
+    }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
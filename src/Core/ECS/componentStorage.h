@@ -0,0 +1,282 @@
+#ifndef CORE_ECS_COMPONENTSTORAGE
+#define CORE_ECS_COMPONENTSTORAGE
+
+#include "util.h"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+// every component is its own shared_ptr allocation (default)
+struct shared_storage
+{
+};
+
+// components are packed by value into one contiguous array and handed out through ComponentHandles
+struct dense_storage
+{
+};
+
+// empty types (e.g. markers like RenderComponent) only store which entities own them in a bitset and a packed list
+struct tag_storage
+{
+};
+
+// a component type opts into a storage policy by declaring a storage_policy member type or by specializing this struct
+// (empty types use tag_storage by default)
+template <typename ComponentType, typename = void>
+struct storage_policy
+{
+    using type = std::conditional_t<std::is_empty<ComponentType>::value, tag_storage, shared_storage>;
+};
+
+template <typename ComponentType>
+struct storage_policy<ComponentType, std::void_t<typename ComponentType::storage_policy>>
+{
+    using type = typename ComponentType::storage_policy;
+};
+
+template <typename ComponentType, typename Policy>
+class ComponentStorage;
+
+template <typename ComponentType>
+class ComponentStorage<ComponentType, shared_storage>
+{
+private:
+    std::vector<std::shared_ptr<ComponentType>> m_components{};
+    // index of every stored component
+    std::unordered_map<const ComponentType *, unsigned int> m_indices{};
+
+public:
+    using pointer = std::shared_ptr<ComponentType>;
+    using weak_pointer = std::weak_ptr<ComponentType>;
+
+    // creates a component that isn't stored yet (it is stored on insert)
+    template <typename... Args>
+    pointer create(Args &&...args)
+    {
+        return std::make_shared<ComponentType>(std::forward<Args>(args)...);
+    }
+
+    // returns the index of the component or -1 if it isn't stored
+    int find(const weak_pointer &weakComponent) const
+    {
+        auto found = m_indices.find(weakComponent.lock().get());
+        if (found == m_indices.end())
+        {
+            return -1;
+        }
+
+        return found->second;
+    }
+
+    int insert(const weak_pointer &component)
+    {
+        m_components.push_back(component.lock());
+        m_indices[m_components.back().get()] = m_components.size() - 1;
+        return m_components.size() - 1;
+    }
+
+    // moves the last component into the freed index
+    void erase(unsigned int index)
+    {
+        m_indices.erase(m_components[index].get());
+        if (index != m_components.size() - 1)
+        {
+            m_components[index] = std::move(m_components.back());
+            m_indices[m_components[index].get()] = index;
+        }
+        m_components.pop_back();
+    }
+
+    void reserve(unsigned int size)
+    {
+        m_components.reserve(size);
+        m_indices.reserve(size);
+    }
+
+    void swap(unsigned int a, unsigned int b)
+    {
+        std::swap(m_components[a], m_components[b]);
+        m_indices[m_components[a].get()] = a;
+        m_indices[m_components[b].get()] = b;
+    }
+
+    const pointer &get(unsigned int index) const { return m_components[index]; }
+
+    ComponentType &at(unsigned int index) { return *m_components[index]; }
+
+    unsigned int size() const { return m_components.size(); }
+
+    std::vector<pointer> pointers() const { return m_components; }
+};
+
+// non-owning reference to a densely stored component; it stays valid while the component is moved around inside the
+// storage and expires once the component is removed
+template <typename ComponentType>
+class ComponentHandle
+{
+private:
+    using storage_type = ComponentStorage<ComponentType, dense_storage>;
+
+    storage_type *m_storage{nullptr};
+    unsigned int m_slot{0};
+    unsigned int m_generation{0};
+
+public:
+    ComponentHandle() {}
+    ComponentHandle(std::nullptr_t) {}
+    ComponentHandle(storage_type *storage, unsigned int slot, unsigned int generation)
+        : m_storage{storage}, m_slot{slot}, m_generation{generation}
+    {
+    }
+
+    // returns nullptr if the component was removed
+    ComponentType *get() const { return m_storage ? m_storage->resolve(m_slot, m_generation) : nullptr; }
+
+    // mirrors weak_ptr so callbacks look the same for every storage policy
+    ComponentType *lock() const { return get(); }
+    bool expired() const { return get() == nullptr; }
+
+    ComponentType &operator*() const { return *get(); }
+    ComponentType *operator->() const { return get(); }
+
+    explicit operator bool() const { return get() != nullptr; }
+
+    bool operator==(const ComponentHandle &other) const
+    {
+        return m_storage == other.m_storage && m_slot == other.m_slot && m_generation == other.m_generation;
+    }
+    bool operator!=(const ComponentHandle &other) const { return !(*this == other); }
+    bool operator==(std::nullptr_t) const { return get() == nullptr; }
+    bool operator!=(std::nullptr_t) const { return get() != nullptr; }
+
+    friend storage_type;
+};
+
+// slot map: components are kept packed in one array while handles go through a slot indirection
+template <typename ComponentType>
+class ComponentStorage<ComponentType, dense_storage>
+{
+private:
+    std::vector<ComponentType> m_components{};
+    // slot of each packed component
+    std::vector<unsigned int> m_slots{};
+    // packed index of each slot
+    std::vector<unsigned int> m_indices{};
+    // increased every time a slot is freed to invalidate old handles
+    std::vector<unsigned int> m_generations{};
+    std::vector<unsigned int> m_freeSlots{};
+
+public:
+    using pointer = ComponentHandle<ComponentType>;
+    using weak_pointer = ComponentHandle<ComponentType>;
+
+    // constructs the component in place (it is stored right away)
+    template <typename... Args>
+    pointer create(Args &&...args)
+    {
+        unsigned int slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = m_indices.size();
+            m_indices.push_back(0);
+            m_generations.push_back(0);
+        }
+
+        m_components.emplace_back(std::forward<Args>(args)...);
+        m_indices[slot] = m_components.size() - 1;
+        m_slots.push_back(slot);
+
+        return pointer{this, slot, m_generations[slot]};
+    }
+
+    int find(const weak_pointer &component) const
+    {
+        if (component.m_storage != this || component.m_slot >= m_generations.size() ||
+            m_generations[component.m_slot] != component.m_generation)
+        {
+            return -1;
+        }
+
+        return m_indices[component.m_slot];
+    }
+
+    int insert(const weak_pointer &component)
+    {
+        (void)component;
+        throw "Can't add a component that isn't part of this table!";
+    }
+
+    // moves the last component into the freed index
+    void erase(unsigned int index)
+    {
+        unsigned int slot = m_slots[index];
+        ++m_generations[slot];
+        m_freeSlots.push_back(slot);
+
+        if (index != m_components.size() - 1)
+        {
+            m_components[index] = std::move(m_components.back());
+            m_slots[index] = m_slots.back();
+            m_indices[m_slots[index]] = index;
+        }
+        m_components.pop_back();
+        m_slots.pop_back();
+    }
+
+    void reserve(unsigned int size)
+    {
+        m_components.reserve(size);
+        m_slots.reserve(size);
+    }
+
+    // handles go through the slots so they follow their components
+    void swap(unsigned int a, unsigned int b)
+    {
+        using std::swap;
+        swap(m_components[a], m_components[b]);
+        std::swap(m_slots[a], m_slots[b]);
+        m_indices[m_slots[a]] = a;
+        m_indices[m_slots[b]] = b;
+    }
+
+    pointer get(unsigned int index) { return pointer{this, m_slots[index], m_generations[m_slots[index]]}; }
+
+    ComponentType &at(unsigned int index) { return m_components[index]; }
+
+    ComponentType *resolve(unsigned int slot, unsigned int generation)
+    {
+        if (slot >= m_generations.size() || m_generations[slot] != generation)
+        {
+            return nullptr;
+        }
+
+        return &m_components[m_indices[slot]];
+    }
+
+    unsigned int size() const { return m_components.size(); }
+
+    std::vector<pointer> pointers()
+    {
+        std::vector<pointer> out{};
+        out.reserve(m_components.size());
+        for (unsigned int i = 0; i < m_components.size(); ++i)
+        {
+            out.push_back(get(i));
+        }
+
+        return out;
+    }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -1,151 +1,361 @@
 #ifndef CORE_ECS_COMPONENTTABLE
 #define CORE_ECS_COMPONENTTABLE
 
+#include "componentStorage.h"
+#include "signal.h"
+#include "sparseArray.h"
 #include <algorithm>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace Engine
 {
+// numbers about one component table to find bloated tables and event storms
+struct ComponentTableStats
+{
+    std::string name{};
+    // stored components (a shared component counts once)
+    std::size_t numComponents{0};
+    // entities owning a component (one owner list node each)
+    std::size_t numOwners{0};
+    // entries in the allocated pages of the sparse arrays
+    std::size_t sparseCapacity{0};
+    // connected callbacks over all signals of the table
+    std::size_t numCallbacks{0};
+    // rough estimate of the bytes held by the table (allocator overhead isn't included)
+    std::size_t memory{0};
+    // events since the last reset
+    unsigned long long numAdded{0};
+    unsigned long long numRemoved{0};
+    unsigned long long numUpdated{0};
+};
+
+// plain non-owning reference to a component for read paths that shouldn't touch reference counts
+// it must not outlive the component; debug builds remember the table and entity it came from and throw if the entity
+// doesn't own the referenced component anymore when it is accessed
 template <typename ComponentType>
+class ComponentRef
+{
+private:
+    ComponentType *m_component{nullptr};
+#ifndef NDEBUG
+    using lookup_function = ComponentType *(*)(void *table, unsigned int entity);
+
+    void *m_table{nullptr};
+    unsigned int m_entity{0};
+    lookup_function m_lookup{nullptr};
+
+    void check() const
+    {
+        if (m_lookup && m_lookup(m_table, m_entity) != m_component)
+        {
+            throw "Component reference used after the component was removed or moved!";
+        }
+    }
+#endif
+
+public:
+    ComponentRef() {}
+    ComponentRef(std::nullptr_t) {}
+#ifndef NDEBUG
+    ComponentRef(ComponentType *component, void *table, unsigned int entity, lookup_function lookup)
+        : m_component{component}, m_table{table}, m_entity{entity}, m_lookup{lookup}
+    {
+    }
+#else
+    ComponentRef(ComponentType *component, void *, unsigned int, ComponentType *(*)(void *, unsigned int))
+        : m_component{component}
+    {
+    }
+#endif
+
+    ComponentType *get() const
+    {
+#ifndef NDEBUG
+        check();
+#endif
+        return m_component;
+    }
+
+    ComponentType &operator*() const { return *get(); }
+    ComponentType *operator->() const { return get(); }
+
+    explicit operator bool() const { return m_component != nullptr; }
+};
+
+template <typename ComponentType,
+          typename StoragePolicy = typename storage_policy<ComponentType>::type,
+          typename Config = entity_config32>
 struct ComponentTable
 {
+public:
+    using entity_type = typename Config::entity_type;
+    using index_type = typename Config::index_type;
+    using storage_type = ComponentStorage<ComponentType, StoragePolicy>;
+    // shared_ptr for shared storage and ComponentHandle for dense storage
+    using pointer = typename storage_type::pointer;
+    using weak_pointer = typename storage_type::weak_pointer;
+
+    // callbacks stay connected as long as the Connection returned on registration is held
+    using signal_type = Signal<void(unsigned int, weak_pointer)>;
+
 private:
-    std::vector<int> m_sparse;
-    std::vector<std::shared_ptr<ComponentType>> m_components{};
-    std::vector<std::list<unsigned int>> m_owners{};
+    // index of the component of each entity
+    PagedSparseArray<index_type> m_sparse{-1};
+    storage_type m_components{};
+    std::vector<std::list<entity_type>> m_owners{};
+    // packed list of all entities that own a component of this type
+    std::vector<entity_type> m_entities{};
+    // position of each entity inside m_entities
+    PagedSparseArray<index_type> m_positions{-1};
+    // node of each entity in the owner list of its component (in the order of m_entities) to unlink it in O(1)
+    // (the nodes stay valid when the owner lists are swapped or moved by a reallocation of m_owners)
+    std::vector<typename std::list<entity_type>::iterator> m_ownerNodes{};
+    static_assert(std::is_nothrow_move_constructible<std::list<entity_type>>::value,
+                  "owner list nodes have to survive reallocations of the owner lists");
 
-    // the implementation of the callback system is based on this blog post:
-    // http://nercury.github.io/c++/interesting/2016/02/22/weak_ptr-and-event-cleanup.html
-    using component_table_callback = std::function<void(unsigned int, std::weak_ptr<ComponentType>)>;
     // callbacks that are called after a component was added to any entity
-    std::list<std::weak_ptr<component_table_callback>> m_addCallbacks{};
+    signal_type m_addCallbacks{};
+    // callbacks that are called once after components were created for a range of entities
+    Signal<void(const std::vector<unsigned int> &)> m_addRangeCallbacks{};
     // callbacks that are called before a component is removed from any entity
-    std::list<std::weak_ptr<component_table_callback>> m_removeCallbacks{};
+    signal_type m_removeCallbacks{};
     // callbacks that are called when any component is updated
-    std::list<std::weak_ptr<component_table_callback>> m_updateCallbacks{};
+    signal_type m_updateCallbacks{};
     // callbacks for when the component on an entity is swapped out with another
-    std::list<std::weak_ptr<component_table_callback>> m_swapCallbacks{};
-    // callbacks for the updates of a specific component
-    std::vector<std::list<std::weak_ptr<component_table_callback>>> m_componentUpdateCallbacks{};
+    signal_type m_swapCallbacks{};
+    // callbacks for the updates of specific components (all of them live in one signal)
+    signal_type m_componentUpdateSignal{};
+    // ids of the callbacks for the updates of each component
+    std::vector<std::vector<SlotId>> m_componentUpdateCallbacks{};
+
+    // increased on every change to the table
+    unsigned long long m_tick{0};
+    // tick of the last time each component was added to an entity or updated
+    std::vector<unsigned long long> m_changeTicks{};
+
+    // events since the last resetStats()
+    unsigned long long m_numAdded{0};
+    unsigned long long m_numRemoved{0};
+    unsigned long long m_numUpdated{0};
 
     //  Add component only if it does not exit: return index
-    int ensureComponent(std::weak_ptr<ComponentType> weakComponent)
+    int ensureComponent(const weak_pointer &component)
     {
-        std::shared_ptr<ComponentType> component{weakComponent.lock()};
-        for (unsigned int i = 0; i < m_components.size(); ++i)
+        int index = m_components.find(component);
+        if (index == -1)
         {
-            if (m_components[i] == component)
-            {
-                return i;
-            }
+            index = m_components.insert(component);
+        }
+
+        // dense storage constructs components in place so they are stored before they get their owner list
+        while (m_owners.size() < m_components.size())
+        {
+            m_owners.push_back(std::list<entity_type>{});
+            m_componentUpdateCallbacks.push_back(std::vector<SlotId>{});
+            m_changeTicks.push_back(0);
         }
 
-        m_components.push_back(component);
-        m_owners.push_back(std::list<unsigned int>{});
-        m_componentUpdateCallbacks.push_back(std::list<std::weak_ptr<component_table_callback>>{});
-        return m_components.size() - 1;
+        return index;
     }
 
-    void ensureEntity(unsigned int entityId)
+    // makes the entity (which doesn't own a component of this type) an owner of the stored component
+    void attach(unsigned int entityId, int componentIndex)
     {
-        if (entityId >= m_sparse.size())
+        m_sparse.set(entityId, componentIndex);
+        m_changeTicks[componentIndex] = ++m_tick;
+        ++m_numAdded;
+        m_positions.set(entityId, m_entities.size());
+        m_entities.push_back(entityId);
+        m_ownerNodes.push_back(m_owners[componentIndex].insert(m_owners[componentIndex].end(), entityId));
+    }
+
+    void swapComponents(unsigned int a, unsigned int b)
+    {
+        m_components.swap(a, b);
+        m_owners[a].swap(m_owners[b]);
+        m_componentUpdateCallbacks[a].swap(m_componentUpdateCallbacks[b]);
+        std::swap(m_changeTicks[a], m_changeTicks[b]);
+        for (unsigned int owner : m_owners[a])
+        {
+            m_sparse.set(owner, a);
+        }
+        for (unsigned int owner : m_owners[b])
         {
-            m_sparse.resize(entityId + 1, -1);
+            m_sparse.set(owner, b);
         }
     }
 
-    void invokeAndCleanup(std::list<std::weak_ptr<component_table_callback>> &cbs,
-                          unsigned int entityId,
-                          std::weak_ptr<ComponentType> component)
+    // moves the components into the given order (order[i] is the current index of the component that ends up at i)
+    void arrange(const std::vector<unsigned int> &order)
     {
-        // invoke all callbacks that are still valid
-        for (std::weak_ptr<component_table_callback> &cb : cbs)
+        // current index of every component and the component currently at every index (by their original index)
+        std::vector<unsigned int> indices(order.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::vector<unsigned int> components{indices};
+
+        for (unsigned int i = 0; i < order.size(); ++i)
+        {
+            unsigned int current = indices[order[i]];
+            if (current != i)
+            {
+                swapComponents(i, current);
+                indices[components[i]] = current;
+                components[current] = components[i];
+                indices[order[i]] = i;
+                components[i] = order[i];
+            }
+        }
+    }
+
+    void arrangeEntities(std::vector<entity_type> &entities)
+    {
+        m_entities.swap(entities);
+        for (unsigned int i = 0; i < m_entities.size(); ++i)
+        {
+            m_positions.set(m_entities[i], i);
+        }
+        for (std::list<entity_type> &owners : m_owners)
         {
-            if (std::shared_ptr<component_table_callback> callback = cb.lock())
+            for (auto node = owners.begin(); node != owners.end(); ++node)
             {
-                (*callback)(entityId, component);
+                m_ownerNodes[m_positions.get(*node)] = node;
             }
         }
+    }
 
-        // remove all invalid callbacks
-        cbs.erase(std::remove_if(
-                      cbs.begin(), cbs.end(), [](std::weak_ptr<component_table_callback> cb) { return cb.expired(); }),
-                  cbs.end());
+    static ComponentType *lookup(void *table, unsigned int entityId)
+    {
+        ComponentTable *self = static_cast<ComponentTable *>(table);
+        return self->contains(entityId) ? &self->get(entityId) : nullptr;
     }
 
 public:
-    ComponentTable(unsigned int numEntities) { m_sparse = std::vector<int>(numEntities, -1); }
+    ComponentTable() {}
+    // the sparse arrays grow on demand so the number of entities isn't needed anymore
+    ComponentTable(unsigned int numEntities) { (void)numEntities; }
 
     template <typename... Args>
-    std::shared_ptr<ComponentType> createComponent(unsigned int entityId, Args &&...args)
+    pointer createComponent(unsigned int entityId, Args &&...args)
     {
-        auto component = std::make_shared<ComponentType>(std::forward<Args>(args)...);
+        pointer component = m_components.create(std::forward<Args>(args)...);
         return addComponent(entityId, component);
     }
 
-    std::shared_ptr<ComponentType> addComponent(unsigned int entityId, std::weak_ptr<ComponentType> component)
+    // creates a component for every given entity; the storage is reserved once and the add callbacks are only invoked
+    // after all components are stored followed by a single invocation of the range callbacks
+    template <typename... Args>
+    std::vector<pointer> createComponents(const std::vector<unsigned int> &entityIds, const Args &...args)
+    {
+        std::vector<pointer> created{};
+        if (entityIds.empty())
+        {
+            return created;
+        }
+
+        created.reserve(entityIds.size());
+        m_components.reserve(m_components.size() + entityIds.size());
+        m_owners.reserve(m_owners.size() + entityIds.size());
+        m_componentUpdateCallbacks.reserve(m_componentUpdateCallbacks.size() + entityIds.size());
+        m_changeTicks.reserve(m_changeTicks.size() + entityIds.size());
+        m_entities.reserve(m_entities.size() + entityIds.size());
+        m_ownerNodes.reserve(m_ownerNodes.size() + entityIds.size());
+
+        std::vector<unsigned int> added{};
+        added.reserve(entityIds.size());
+        for (unsigned int entityId : entityIds)
+        {
+            pointer component = m_components.create(args...);
+
+            // entities that already own a component get theirs swapped out like in addComponent
+            if (contains(entityId))
+            {
+                created.push_back(addComponent(entityId, component));
+                continue;
+            }
+
+            int componentIndex = ensureComponent(component);
+            attach(entityId, componentIndex);
+            created.push_back(m_components.get(componentIndex));
+            added.push_back(entityId);
+        }
+
+        for (unsigned int entityId : added)
+        {
+            // an earlier callback might have removed the component again
+            if (contains(entityId))
+            {
+                m_addCallbacks(entityId, m_components.get(m_sparse.get(entityId)));
+            }
+        }
+        m_addRangeCallbacks(added);
+
+        return created;
+    }
+
+    pointer addComponent(unsigned int entityId, weak_pointer component)
     {
-        ensureEntity(entityId);
         int componentIndex = ensureComponent(component);
 
         bool override = false;
 
-        int currentComponentIndex = m_sparse[entityId];
+        int currentComponentIndex = m_sparse.get(entityId);
 
         // entity has a component
         if (currentComponentIndex != -1)
         {
             // if the entity already points to the component
-            if (m_components[currentComponentIndex] == component.lock())
+            if (currentComponentIndex == componentIndex)
             {
-                return m_components[currentComponentIndex];
+                return m_components.get(currentComponentIndex);
             }
 
             override = true;
-            invokeAndCleanup(m_swapCallbacks, entityId, component);
+            m_swapCallbacks(entityId, component);
             // if the entity points to another component
             // remove the other component from the entity
-            bool deleted = removeComponent(entityId, override);
-            // correct the index if needed ()
-            if (deleted && componentIndex > currentComponentIndex)
+            // the component may have been moved if the other component was deleted
+            if (removeComponent(entityId, override))
             {
-                --componentIndex;
+                componentIndex = m_components.find(component);
             }
         }
 
-        m_sparse[entityId] = componentIndex;
-        m_owners[componentIndex].push_back(entityId);
+        attach(entityId, componentIndex);
 
         if (!override)
         {
-            invokeAndCleanup(m_addCallbacks, entityId, m_components[componentIndex]);
+            m_addCallbacks(entityId, m_components.get(componentIndex));
         }
 
-        return m_components[m_sparse[entityId]];
+        return m_components.get(m_sparse.get(entityId));
     }
 
     bool removeComponent(unsigned int entityId, bool silent = false)
     {
-        ensureEntity(entityId);
         // entity has no component of this type
-        if (m_sparse[entityId] == -1)
+        if (m_sparse.get(entityId) == -1)
         {
             return false;
         }
 
-        unsigned int componentIndex = m_sparse[entityId];
+        unsigned int componentIndex = m_sparse.get(entityId);
 
         if (!silent)
         {
-            invokeAndCleanup(m_removeCallbacks, entityId, m_components[componentIndex]);
+            m_removeCallbacks(entityId, m_components.get(componentIndex));
         }
 
         // remove entity from owner list
-        std::list<unsigned int> &allOwners = m_owners[componentIndex];
-        allOwners.remove(entityId);
+        std::list<entity_type> &allOwners = m_owners[componentIndex];
+        allOwners.erase(m_ownerNodes[m_positions.get(entityId)]);
+        ++m_numRemoved;
 
         // return value to indicate if the component was deleted
         bool deleted = false;
@@ -153,129 +363,693 @@ public:
         if (allOwners.size() == 0)
         {
             deleted = true;
-            auto it = m_components.begin();
-            // decrease the pointed to index of all entities which point to a
-            // following component
-            auto ownerIt = m_owners.begin();
-            for (auto following{ownerIt + componentIndex + 1}; following != m_owners.end(); ++following)
+            for (SlotId callback : m_componentUpdateCallbacks[componentIndex])
+            {
+                m_componentUpdateSignal.disconnect(callback);
+            }
+
+            // the last component is moved into the freed index so its owners have to point there
+            unsigned int lastIndex = m_components.size() - 1;
+            if (componentIndex != lastIndex)
             {
-                for (unsigned int owner : *following)
+                for (unsigned int owner : m_owners[lastIndex])
                 {
-                    m_sparse[owner]--;
+                    m_sparse.set(owner, componentIndex);
                 }
+                m_owners[componentIndex].swap(m_owners[lastIndex]);
+                m_componentUpdateCallbacks[componentIndex].swap(m_componentUpdateCallbacks[lastIndex]);
+                m_changeTicks[componentIndex] = m_changeTicks[lastIndex];
             }
 
-            m_components.erase(it + componentIndex);
-            m_owners.erase(m_owners.begin() + componentIndex);
-            m_componentUpdateCallbacks.erase(m_componentUpdateCallbacks.begin() + componentIndex);
+            m_components.erase(componentIndex);
+            m_owners.pop_back();
+            m_componentUpdateCallbacks.pop_back();
+            m_changeTicks.pop_back();
         }
 
-        m_sparse[entityId] = -1;
+        // swap the entity with the last one in the packed list
+        unsigned int lastEntity = m_entities.back();
+        m_entities[m_positions.get(entityId)] = lastEntity;
+        m_ownerNodes[m_positions.get(entityId)] = m_ownerNodes.back();
+        m_positions.set(lastEntity, m_positions.get(entityId));
+        m_entities.pop_back();
+        m_ownerNodes.pop_back();
+        m_positions.set(entityId, -1);
+
+        m_sparse.set(entityId, -1);
         return deleted;
     }
 
     bool hasComponent(unsigned int entityId)
     {
-        ensureEntity(entityId);
-        return m_sparse[entityId] != -1;
+        return m_sparse.get(entityId) != -1;
     }
 
-    std::shared_ptr<ComponentType> getComponent(unsigned int entityId)
+    pointer getComponent(unsigned int entityId)
     {
-        ensureEntity(entityId);
-
-        if (m_sparse[entityId] == -1)
+        if (m_sparse.get(entityId) == -1)
         {
             return nullptr;
         }
 
-        return m_components[m_sparse[entityId]];
+        return m_components.get(m_sparse.get(entityId));
+    }
+
+    // checks for a component without growing the table (safe for concurrent readers)
+    bool contains(unsigned int entityId) const { return m_sparse.get(entityId) != -1; }
+
+    // unchecked access to the component of an entity that is known to own one
+    ComponentType &get(unsigned int entityId) { return m_components.at(m_sparse.get(entityId)); }
+
+    ComponentRef<ComponentType> getRef(unsigned int entityId)
+    {
+        return ComponentRef<ComponentType>{lookup(this, entityId), this, entityId, &ComponentTable::lookup};
+    }
+
+    std::vector<pointer> getComponents() { return m_components.pointers(); }
+
+    const std::vector<entity_type> &getEntities() const { return m_entities; }
+
+    // iterates over the stored components without touching any reference counts (components shared by multiple
+    // entities are only visited once)
+    template <typename Func>
+    void each(Func func)
+    {
+        for (unsigned int i = 0; i < m_components.size(); ++i)
+        {
+            func(m_components.at(i));
+        }
+    }
+
+    std::vector<std::list<entity_type>> &getOwners() { return m_owners; }
+
+    std::list<entity_type> &getOwners(weak_pointer component)
+    {
+        int index = m_components.find(component);
+        if (index == -1)
+        {
+            throw "Can't return owners of non-existant component!";
+        }
+
+        return m_owners[index];
+    }
+
+    std::list<entity_type> &getOwners(unsigned int entity)
+    {
+        if (m_sparse.get(entity) == -1)
+        {
+            throw "Can't return owners of non-existant component!";
+        }
+
+        return m_owners.at(m_sparse.get(entity));
     }
 
-    std::vector<std::shared_ptr<ComponentType>> getComponents() { return m_components; }
+    // orders the stored components with the comparator (called with two components) and the entities by the order of
+    // their components; pointers to the components and their callbacks stay valid
+    template <typename Compare>
+    void sort(Compare compare)
+    {
+        std::vector<unsigned int> order(m_components.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&](unsigned int a, unsigned int b)
+                         { return compare(m_components.at(a), m_components.at(b)); });
+        arrange(order);
 
-    std::vector<std::list<unsigned int>> &getOwners() { return m_owners; }
+        std::vector<entity_type> entities{};
+        entities.reserve(m_entities.size());
+        for (const std::list<entity_type> &owners : m_owners)
+        {
+            entities.insert(entities.end(), owners.begin(), owners.end());
+        }
+        arrangeEntities(entities);
+    }
 
-    std::list<unsigned int> &getOwners(std::weak_ptr<ComponentType> component)
+    // orders the entities (and their components) like the given entities; entities that aren't in the list come last
+    // in their current order
+    void sortAs(const std::vector<entity_type> &order)
     {
-        for (unsigned int i{0}; i < m_owners.size(); ++i)
+        std::vector<unsigned int> componentOrder{};
+        componentOrder.reserve(m_components.size());
+        std::vector<bool> placed(m_components.size(), false);
+        std::vector<entity_type> entities{};
+        entities.reserve(m_entities.size());
+
+        for (unsigned int entity : order)
+        {
+            int index = m_sparse.get(entity);
+            if (index == -1)
+            {
+                continue;
+            }
+
+            entities.push_back(entity);
+            // shared components are placed at their first owner
+            if (!placed[index])
+            {
+                placed[index] = true;
+                componentOrder.push_back(index);
+            }
+        }
+
+        for (unsigned int i = 0; i < m_components.size(); ++i)
         {
-            if (m_components[i] == component.lock())
+            if (!placed[i])
             {
-                return m_owners[i];
+                componentOrder.push_back(i);
             }
         }
 
-        throw "Can't return owners of non-existant component!";
+        // the list has no duplicates so an entity was already placed iff it is at its position in the new list
+        for (unsigned int i = 0; i < entities.size(); ++i)
+        {
+            m_positions.set(entities[i], i);
+        }
+        unsigned int numPlaced = entities.size();
+        for (unsigned int entity : m_entities)
+        {
+            unsigned int position = m_positions.get(entity);
+            if (position >= numPlaced || entities[position] != entity)
+            {
+                entities.push_back(entity);
+            }
+        }
+
+        arrange(componentOrder);
+        arrangeEntities(entities);
+    }
+
+    ComponentTableStats stats() const
+    {
+        ComponentTableStats stats{};
+        stats.name = type_name<ComponentType>();
+        stats.numComponents = m_components.size();
+        stats.numOwners = m_entities.size();
+        stats.sparseCapacity = m_sparse.getCapacity() + m_positions.getCapacity();
+        stats.numCallbacks = m_addCallbacks.size() + m_addRangeCallbacks.size() + m_removeCallbacks.size() +
+                             m_updateCallbacks.size() + m_swapCallbacks.size() + m_componentUpdateSignal.size();
+
+        // shared components are separate allocations next to their pointers while dense ones are stored in place
+        std::size_t componentSize = std::is_same<StoragePolicy, dense_storage>::value
+                                        ? sizeof(ComponentType) + 2 * sizeof(unsigned int)
+                                        : sizeof(ComponentType) + sizeof(pointer);
+        // owner lists are doubly linked
+        std::size_t ownerSize = sizeof(entity_type) + 2 * sizeof(void *);
+        stats.memory = stats.numComponents * componentSize + m_owners.capacity() * sizeof(std::list<entity_type>) +
+                       stats.numOwners * ownerSize + m_entities.capacity() * sizeof(entity_type) +
+                       m_ownerNodes.capacity() * sizeof(typename std::list<entity_type>::iterator) +
+                       stats.sparseCapacity * sizeof(index_type) +
+                       m_changeTicks.capacity() * sizeof(unsigned long long) +
+                       m_componentUpdateCallbacks.capacity() * sizeof(std::vector<SlotId>);
+
+        stats.numAdded = m_numAdded;
+        stats.numRemoved = m_numRemoved;
+        stats.numUpdated = m_numUpdated;
+
+        return stats;
+    }
+
+    void resetStats()
+    {
+        m_numAdded = 0;
+        m_numRemoved = 0;
+        m_numUpdated = 0;
+    }
+
+    // current change tick of the table; remember it to later ask for the changes made after this point
+    unsigned long long getTick() const { return m_tick; }
+
+    // true if the component of the entity was added or updated after the given tick
+    bool changedSince(unsigned int entityId, unsigned long long tick) const
+    {
+        return contains(entityId) && m_changeTicks[m_sparse.get(entityId)] > tick;
     }
 
-    std::list<unsigned int> &getOwners(unsigned int entity)
+    // returns all entities whose component was added or updated after the given tick (all owners of a changed shared
+    // component are returned)
+    std::vector<unsigned int> changedSince(unsigned long long tick) const
     {
-        if (m_sparse[entity] == -1)
+        std::vector<unsigned int> changed{};
+        if (tick >= m_tick)
         {
-            throw "Can't return owners of non-existant component!";
+            return changed;
+        }
+
+        for (unsigned int i = 0; i < m_changeTicks.size(); ++i)
+        {
+            if (m_changeTicks[i] > tick)
+            {
+                changed.insert(changed.end(), m_owners[i].begin(), m_owners[i].end());
+            }
         }
 
-        return m_owners.at(m_sparse[entity]);
+        return changed;
     }
 
-    std::shared_ptr<component_table_callback> onAdded(component_table_callback &&cb)
+    template <typename Func>
+    Connection onAdded(Func &&cb)
     {
-        std::shared_ptr<component_table_callback> shared = std::make_shared<component_table_callback>(cb);
-        m_addCallbacks.push_back(shared);
-        return shared;
+        return m_addCallbacks.connect(std::forward<Func>(cb));
     }
 
-    std::shared_ptr<component_table_callback> onRemove(component_table_callback &&cb)
+    // the callbacks get all entities that got a new component through createComponents (the add callbacks are invoked
+    // for each of them as well)
+    template <typename Func>
+    Connection onAddedRange(Func &&cb)
     {
-        std::shared_ptr<component_table_callback> shared = std::make_shared<component_table_callback>(cb);
-        m_removeCallbacks.push_back(shared);
-        return shared;
+        return m_addRangeCallbacks.connect(std::forward<Func>(cb));
     }
 
-    std::shared_ptr<component_table_callback> onUpdate(component_table_callback &&cb)
+    template <typename Func>
+    Connection onRemove(Func &&cb)
     {
-        std::shared_ptr<component_table_callback> shared = std::make_shared<component_table_callback>(cb);
-        m_updateCallbacks.push_back(shared);
-        return shared;
+        return m_removeCallbacks.connect(std::forward<Func>(cb));
     }
 
-    std::shared_ptr<component_table_callback> onUpdate(unsigned int entityId, component_table_callback &&cb)
+    template <typename Func>
+    Connection onUpdate(Func &&cb)
     {
-        if (m_sparse[entityId] > -1)
+        return m_updateCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    template <typename Func>
+    Connection onUpdate(unsigned int entityId, Func &&cb)
+    {
+        if (!contains(entityId))
         {
-            std::shared_ptr<component_table_callback> shared = std::make_shared<component_table_callback>(cb);
-            m_componentUpdateCallbacks[m_sparse[entityId]].push_back(shared);
-            return shared;
+            return Connection{};
         }
 
-        return std::shared_ptr<component_table_callback>{};
+        std::vector<SlotId> &callbacks = m_componentUpdateCallbacks[m_sparse.get(entityId)];
+        // forget disconnected callbacks (not while they are invoked since updated() iterates over the ids)
+        if (!m_componentUpdateSignal.invoking())
+        {
+            callbacks.erase(std::remove_if(callbacks.begin(),
+                                           callbacks.end(),
+                                           [this](SlotId callback)
+                                           { return !m_componentUpdateSignal.connected(callback); }),
+                            callbacks.end());
+        }
+
+        Connection connection = m_componentUpdateSignal.connect(std::forward<Func>(cb));
+        callbacks.push_back(connection.id());
+        return connection;
     }
 
-    std::shared_ptr<component_table_callback> onComponentSwap(component_table_callback &&cb)
+    template <typename Func>
+    Connection onComponentSwap(Func &&cb)
     {
-        std::shared_ptr<component_table_callback> shared = std::make_shared<component_table_callback>(cb);
-        m_swapCallbacks.push_back(shared);
-        return shared;
+        return m_swapCallbacks.connect(std::forward<Func>(cb));
     }
 
     // called after one updated a coponent of an entity to signal the update to
     // everyone who added a callback
     void updated(unsigned int entityId)
     {
-        int componentIndex = m_sparse[entityId];
+        int componentIndex = m_sparse.get(entityId);
         if (componentIndex > -1)
         {
-            // There was an error where the cb list changed while being inside invokeAndCleanup
-            std::list<std::weak_ptr<component_table_callback>> cbs{m_componentUpdateCallbacks[componentIndex]};
-            invokeAndCleanup(cbs, entityId, m_components[componentIndex]);
-            m_componentUpdateCallbacks[componentIndex] = cbs;
+            m_changeTicks[componentIndex] = ++m_tick;
+            ++m_numUpdated;
+            weak_pointer component{m_components.get(componentIndex)};
+
+            // the callbacks may register new callbacks or move the component inside the table
+            unsigned int numCallbacks = m_componentUpdateCallbacks[componentIndex].size();
+            for (unsigned int i = 0; i < numCallbacks && contains(entityId); ++i)
+            {
+                const std::vector<SlotId> &callbacks = m_componentUpdateCallbacks[m_sparse.get(entityId)];
+                if (i < callbacks.size())
+                {
+                    m_componentUpdateSignal.invoke(callbacks[i], entityId, component);
+                }
+            }
             // has to be this way for now to allow the hierarchyTracker to take effect before the transformTracker for
             // rendering
-            invokeAndCleanup(m_updateCallbacks, entityId, m_components[componentIndex]);
+            m_updateCallbacks(entityId, component);
         }
     }
 };
+
+// table for empty component types; there is nothing to store per entity so ownership is a bit per entity and a packed
+// list of the owners (all entities are handed a pointer to the same instance)
+template <typename ComponentType, typename Config>
+struct ComponentTable<ComponentType, tag_storage, Config>
+{
+public:
+    using entity_type = typename Config::entity_type;
+    using index_type = typename Config::index_type;
+    using pointer = ComponentType *;
+    using weak_pointer = ComponentType *;
+
+    using signal_type = Signal<void(unsigned int, weak_pointer)>;
+
+private:
+    ComponentType m_tag{};
+    // one bit per entity id
+    std::vector<std::uint64_t> m_bits{};
+    // packed list of all entities that own the tag
+    std::vector<entity_type> m_entities{};
+    // position of each entity inside m_entities
+    PagedSparseArray<index_type> m_positions{-1};
+
+    signal_type m_addCallbacks{};
+    Signal<void(const std::vector<unsigned int> &)> m_addRangeCallbacks{};
+    signal_type m_removeCallbacks{};
+    signal_type m_updateCallbacks{};
+    signal_type m_swapCallbacks{};
+    signal_type m_componentUpdateSignal{};
+    // ids of the update callbacks of each owner (in the order of m_entities)
+    std::vector<std::vector<SlotId>> m_componentUpdateCallbacks{};
+
+    unsigned long long m_tick{0};
+    // tick of the last change for each owner (in the order of m_entities)
+    std::vector<unsigned long long> m_changeTicks{};
+
+    unsigned long long m_numAdded{0};
+    unsigned long long m_numRemoved{0};
+    unsigned long long m_numUpdated{0};
+
+    static ComponentType *lookup(void *table, unsigned int entityId)
+    {
+        ComponentTable *self = static_cast<ComponentTable *>(table);
+        return self->contains(entityId) ? &self->m_tag : nullptr;
+    }
+
+    void attach(unsigned int entityId)
+    {
+        if (entityId / 64 >= m_bits.size())
+        {
+            m_bits.resize(entityId / 64 + 1, 0);
+        }
+        m_bits[entityId / 64] |= std::uint64_t{1} << (entityId % 64);
+
+        m_positions.set(entityId, m_entities.size());
+        m_entities.push_back(entityId);
+        m_componentUpdateCallbacks.push_back(std::vector<SlotId>{});
+        m_changeTicks.push_back(++m_tick);
+        ++m_numAdded;
+    }
+
+public:
+    ComponentTable() {}
+    ComponentTable(unsigned int numEntities) { (void)numEntities; }
+
+    // the arguments are ignored since all owners share the same empty instance
+    template <typename... Args>
+    pointer createComponent(unsigned int entityId, Args &&...)
+    {
+        return addComponent(entityId, &m_tag);
+    }
+
+    template <typename... Args>
+    std::vector<pointer> createComponents(const std::vector<unsigned int> &entityIds, const Args &...)
+    {
+        m_entities.reserve(m_entities.size() + entityIds.size());
+        m_componentUpdateCallbacks.reserve(m_componentUpdateCallbacks.size() + entityIds.size());
+        m_changeTicks.reserve(m_changeTicks.size() + entityIds.size());
+
+        std::vector<unsigned int> added{};
+        added.reserve(entityIds.size());
+        for (unsigned int entityId : entityIds)
+        {
+            if (!contains(entityId))
+            {
+                attach(entityId);
+                added.push_back(entityId);
+            }
+        }
+
+        for (unsigned int entityId : added)
+        {
+            if (contains(entityId))
+            {
+                m_addCallbacks(entityId, &m_tag);
+            }
+        }
+        m_addRangeCallbacks(added);
+
+        return std::vector<pointer>(entityIds.size(), &m_tag);
+    }
+
+    // an entity owning the tag already keeps it without any callbacks being invoked
+    pointer addComponent(unsigned int entityId, weak_pointer)
+    {
+        if (!contains(entityId))
+        {
+            attach(entityId);
+            m_addCallbacks(entityId, &m_tag);
+        }
+
+        return &m_tag;
+    }
+
+    bool removeComponent(unsigned int entityId, bool silent = false)
+    {
+        if (!contains(entityId))
+        {
+            return false;
+        }
+
+        if (!silent)
+        {
+            m_removeCallbacks(entityId, &m_tag);
+
+            // the callbacks might have removed the tag already
+            if (!contains(entityId))
+            {
+                return true;
+            }
+        }
+
+        m_bits[entityId / 64] &= ~(std::uint64_t{1} << (entityId % 64));
+        ++m_numRemoved;
+
+        for (SlotId callback : m_componentUpdateCallbacks[m_positions.get(entityId)])
+        {
+            m_componentUpdateSignal.disconnect(callback);
+        }
+
+        // swap the entity with the last one in the packed list
+        unsigned int position = m_positions.get(entityId);
+        unsigned int lastEntity = m_entities.back();
+        m_entities[position] = lastEntity;
+        m_componentUpdateCallbacks[position].swap(m_componentUpdateCallbacks.back());
+        m_changeTicks[position] = m_changeTicks.back();
+        m_positions.set(lastEntity, position);
+        m_entities.pop_back();
+        m_componentUpdateCallbacks.pop_back();
+        m_changeTicks.pop_back();
+        m_positions.set(entityId, -1);
+
+        return true;
+    }
+
+    bool hasComponent(unsigned int entityId) { return contains(entityId); }
+
+    pointer getComponent(unsigned int entityId) { return contains(entityId) ? &m_tag : nullptr; }
+
+    bool contains(unsigned int entityId) const
+    {
+        return entityId / 64 < m_bits.size() && (m_bits[entityId / 64] >> (entityId % 64)) & 1;
+    }
+
+    ComponentType &get(unsigned int) { return m_tag; }
+
+    ComponentRef<ComponentType> getRef(unsigned int entityId)
+    {
+        return ComponentRef<ComponentType>{lookup(this, entityId), this, entityId, &ComponentTable::lookup};
+    }
+
+    // one pointer per owner
+    std::vector<pointer> getComponents() { return std::vector<pointer>(m_entities.size(), &m_tag); }
+
+    const std::vector<entity_type> &getEntities() const { return m_entities; }
+
+    // visits the tag once per owner
+    template <typename Func>
+    void each(Func func)
+    {
+        for (unsigned int i = 0; i < m_entities.size(); ++i)
+        {
+            func(m_tag);
+        }
+    }
+
+    // all owners share the tag so only the order of the entities changes
+    void sortAs(const std::vector<entity_type> &order)
+    {
+        std::vector<unsigned int> positions{};
+        positions.reserve(m_entities.size());
+        std::vector<bool> placed(m_entities.size(), false);
+
+        for (unsigned int entity : order)
+        {
+            if (contains(entity))
+            {
+                positions.push_back(m_positions.get(entity));
+                placed[positions.back()] = true;
+            }
+        }
+        for (unsigned int i = 0; i < m_entities.size(); ++i)
+        {
+            if (!placed[i])
+            {
+                positions.push_back(i);
+            }
+        }
+
+        std::vector<entity_type> entities(m_entities.size());
+        std::vector<std::vector<SlotId>> callbacks(m_entities.size());
+        std::vector<unsigned long long> ticks(m_entities.size());
+        for (unsigned int i = 0; i < positions.size(); ++i)
+        {
+            entities[i] = m_entities[positions[i]];
+            callbacks[i].swap(m_componentUpdateCallbacks[positions[i]]);
+            ticks[i] = m_changeTicks[positions[i]];
+            m_positions.set(entities[i], i);
+        }
+        m_entities.swap(entities);
+        m_componentUpdateCallbacks.swap(callbacks);
+        m_changeTicks.swap(ticks);
+    }
+
+    ComponentTableStats stats() const
+    {
+        ComponentTableStats stats{};
+        stats.name = type_name<ComponentType>();
+        stats.numComponents = m_entities.empty() ? 0 : 1;
+        stats.numOwners = m_entities.size();
+        stats.sparseCapacity = m_positions.getCapacity();
+        stats.numCallbacks = m_addCallbacks.size() + m_addRangeCallbacks.size() + m_removeCallbacks.size() +
+                             m_updateCallbacks.size() + m_swapCallbacks.size() + m_componentUpdateSignal.size();
+        stats.memory = m_bits.capacity() * sizeof(std::uint64_t) + m_entities.capacity() * sizeof(entity_type) +
+                       stats.sparseCapacity * sizeof(index_type) +
+                       m_changeTicks.capacity() * sizeof(unsigned long long) +
+                       m_componentUpdateCallbacks.capacity() * sizeof(std::vector<SlotId>);
+
+        stats.numAdded = m_numAdded;
+        stats.numRemoved = m_numRemoved;
+        stats.numUpdated = m_numUpdated;
+
+        return stats;
+    }
+
+    void resetStats()
+    {
+        m_numAdded = 0;
+        m_numRemoved = 0;
+        m_numUpdated = 0;
+    }
+
+    unsigned long long getTick() const { return m_tick; }
+
+    bool changedSince(unsigned int entityId, unsigned long long tick) const
+    {
+        return contains(entityId) && m_changeTicks[m_positions.get(entityId)] > tick;
+    }
+
+    std::vector<unsigned int> changedSince(unsigned long long tick) const
+    {
+        std::vector<unsigned int> changed{};
+        for (unsigned int i = 0; i < m_entities.size(); ++i)
+        {
+            if (m_changeTicks[i] > tick)
+            {
+                changed.push_back(m_entities[i]);
+            }
+        }
+
+        return changed;
+    }
+
+    template <typename Func>
+    Connection onAdded(Func &&cb)
+    {
+        return m_addCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    template <typename Func>
+    Connection onAddedRange(Func &&cb)
+    {
+        return m_addRangeCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    template <typename Func>
+    Connection onRemove(Func &&cb)
+    {
+        return m_removeCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    template <typename Func>
+    Connection onUpdate(Func &&cb)
+    {
+        return m_updateCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    template <typename Func>
+    Connection onUpdate(unsigned int entityId, Func &&cb)
+    {
+        if (!contains(entityId))
+        {
+            return Connection{};
+        }
+
+        std::vector<SlotId> &callbacks = m_componentUpdateCallbacks[m_positions.get(entityId)];
+        if (!m_componentUpdateSignal.invoking())
+        {
+            callbacks.erase(std::remove_if(callbacks.begin(),
+                                           callbacks.end(),
+                                           [this](SlotId callback)
+                                           { return !m_componentUpdateSignal.connected(callback); }),
+                            callbacks.end());
+        }
+
+        Connection connection = m_componentUpdateSignal.connect(std::forward<Func>(cb));
+        callbacks.push_back(connection.id());
+        return connection;
+    }
+
+    // tags are never swapped since all owners share the same instance
+    template <typename Func>
+    Connection onComponentSwap(Func &&cb)
+    {
+        return m_swapCallbacks.connect(std::forward<Func>(cb));
+    }
+
+    void updated(unsigned int entityId)
+    {
+        if (!contains(entityId))
+        {
+            return;
+        }
+
+        m_changeTicks[m_positions.get(entityId)] = ++m_tick;
+        ++m_numUpdated;
+
+        unsigned int numCallbacks = m_componentUpdateCallbacks[m_positions.get(entityId)].size();
+        for (unsigned int i = 0; i < numCallbacks && contains(entityId); ++i)
+        {
+            const std::vector<SlotId> &callbacks = m_componentUpdateCallbacks[m_positions.get(entityId)];
+            if (i < callbacks.size())
+            {
+                m_componentUpdateSignal.invoke(callbacks[i], entityId, &m_tag);
+            }
+        }
+        m_updateCallbacks(entityId, &m_tag);
+    }
+};
+
+// table of a component type in a registry with the given entity config
+template <typename ComponentType, typename Config>
+using component_table = ComponentTable<ComponentType, typename storage_policy<ComponentType>::type, Config>;
+
+template <typename ComponentType>
+using component_pointer = typename ComponentTable<ComponentType>::pointer;
+
+template <typename ComponentType>
+using weak_component_pointer = typename ComponentTable<ComponentType>::weak_pointer;
+
 } // namespace Engine
 
 #endif
\ No newline at end of file
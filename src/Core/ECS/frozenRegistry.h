@@ -0,0 +1,138 @@
+#ifndef CORE_ECS_FROZENREGISTRY
+#define CORE_ECS_FROZENREGISTRY
+
+#include "componentTable.h"
+#include "sparseArray.h"
+#include "util.h"
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Engine
+{
+// the components of one type and their owners at the time the table was frozen
+// shared components are kept alive by the frozen table, dense components are copied (their storage moves on removal)
+// and tags share a single instance
+template <typename ComponentType, typename Config = entity_config32>
+class FrozenTable
+{
+private:
+    using policy = typename storage_policy<ComponentType>::type;
+    using entity_type = typename Config::entity_type;
+
+    std::vector<std::shared_ptr<ComponentType>> m_components{};
+    // index of the component of each entity
+    PagedSparseArray<typename Config::index_type> m_sparse{-1};
+    std::vector<entity_type> m_entities{};
+
+public:
+    FrozenTable(component_table<ComponentType, Config> *table) : m_entities{table->getEntities()}
+    {
+        if constexpr (std::is_same<policy, tag_storage>::value)
+        {
+            m_components.push_back(std::make_shared<ComponentType>());
+            for (unsigned int entity : m_entities)
+            {
+                m_sparse.set(entity, 0);
+            }
+        }
+        else
+        {
+            if constexpr (std::is_same<policy, dense_storage>::value)
+            {
+                table->each([this](ComponentType &component)
+                            { m_components.push_back(std::make_shared<ComponentType>(component)); });
+            }
+            else
+            {
+                m_components = table->getComponents();
+            }
+
+            const std::vector<std::list<entity_type>> &owners = table->getOwners();
+            for (unsigned int i = 0; i < owners.size(); ++i)
+            {
+                for (unsigned int owner : owners[i])
+                {
+                    m_sparse.set(owner, i);
+                }
+            }
+        }
+    }
+
+    bool contains(unsigned int entity) const { return m_sparse.get(entity) != -1; }
+
+    ComponentType *get(unsigned int entity) const
+    {
+        int index = m_sparse.get(entity);
+        return index == -1 ? nullptr : m_components[index].get();
+    }
+
+    const std::vector<entity_type> &getEntities() const { return m_entities; }
+};
+
+// read-only copy of the component tables of the given types taken at one point in time
+// nothing inside is changed after construction so any number of threads can query it without locks or reference
+// counting while the registry it was taken from keeps being edited; the registry may add and remove components freely
+// but the shared components themselves must not be written to while readers use them
+template <typename Config, typename... ComponentTypes>
+class BasicFrozenRegistry
+{
+    static_assert(unique_types<ComponentTypes...>::value, "every component type may only be frozen once");
+
+private:
+    std::tuple<FrozenTable<ComponentTypes, Config>...> m_tables;
+
+    template <typename ComponentType>
+    const FrozenTable<ComponentType, Config> &table() const
+    {
+        static_assert(is_one_of<ComponentType, ComponentTypes...>::value, "the component type wasn't frozen");
+        return std::get<FrozenTable<ComponentType, Config>>(m_tables);
+    }
+
+public:
+    BasicFrozenRegistry(component_table<ComponentTypes, Config> *...tables)
+        : m_tables{FrozenTable<ComponentTypes, Config>{tables}...}
+    {
+    }
+
+    template <typename ComponentType>
+    bool hasComponent(unsigned int entity) const
+    {
+        return table<ComponentType>().contains(entity);
+    }
+
+    // returns nullptr if the entity didn't own a component of the type
+    template <typename ComponentType>
+    ComponentType *getComponent(unsigned int entity) const
+    {
+        return table<ComponentType>().get(entity);
+    }
+
+    template <typename ComponentType>
+    const std::vector<typename Config::entity_type> &getEntities() const
+    {
+        return table<ComponentType>().getEntities();
+    }
+
+    // calls the function for every entity that owned a component of every given type
+    template <typename... Types, typename Func>
+    void each(Func func) const
+    {
+        using First = std::tuple_element_t<0, std::tuple<Types...>>;
+
+        for (unsigned int entity : getEntities<First>())
+        {
+            if ((hasComponent<Types>(entity) && ...))
+            {
+                func(entity, *getComponent<Types>(entity)...);
+            }
+        }
+    }
+};
+
+template <typename... ComponentTypes>
+using FrozenRegistry = BasicFrozenRegistry<entity_config32, ComponentTypes...>;
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef CORE_ECS_GROUP
+#define CORE_ECS_GROUP
+
+#include "componentTable.h"
+#include "sparseArray.h"
+#include "view.h"
+#include <tuple>
+#include <vector>
+
+namespace Engine
+{
+// persistent set of all entities that own a component of every given type
+// the set is kept up to date through the add and remove callbacks of the tables instead of being recomputed
+template <typename Config, typename... ComponentTypes>
+class BasicGroup
+{
+private:
+    using entity_type = typename Config::entity_type;
+
+    std::tuple<component_table<ComponentTypes, Config> *...> m_tables;
+    // packed list of the entities in the group
+    std::vector<entity_type> m_entities{};
+    // position of each entity inside m_entities
+    PagedSparseArray<typename Config::index_type> m_positions{-1};
+    // keeps the callbacks into the tables connected
+    std::vector<Connection> m_callbacks{};
+
+    void insert(unsigned int entity)
+    {
+        bool ownsAll = (std::get<component_table<ComponentTypes, Config> *>(m_tables)->contains(entity) && ...);
+        if (m_positions.get(entity) == -1 && ownsAll)
+        {
+            m_positions.set(entity, m_entities.size());
+            m_entities.push_back(entity);
+        }
+    }
+
+    void erase(unsigned int entity)
+    {
+        if (!contains(entity))
+        {
+            return;
+        }
+
+        unsigned int lastEntity = m_entities.back();
+        m_entities[m_positions.get(entity)] = lastEntity;
+        m_positions.set(lastEntity, m_positions.get(entity));
+        m_entities.pop_back();
+        m_positions.set(entity, -1);
+    }
+
+    template <typename ComponentType>
+    void track(component_table<ComponentType, Config> *table)
+    {
+        using weak_pointer = typename component_table<ComponentType, Config>::weak_pointer;
+
+        m_callbacks.push_back(table->onAdded([this](unsigned int entity, weak_pointer) { insert(entity); }));
+        // remove callbacks are called before the component is removed
+        m_callbacks.push_back(table->onRemove([this](unsigned int entity, weak_pointer) { erase(entity); }));
+    }
+
+public:
+    BasicGroup(component_table<ComponentTypes, Config> *...tables) : m_tables{tables...}
+    {
+        (track(tables), ...);
+
+        BasicView<Config, ComponentTypes...>{tables...}.each([this](unsigned int entity, ComponentTypes &...)
+                                                             { insert(entity); });
+    }
+
+    // the callbacks reference the group
+    BasicGroup(const BasicGroup &other) = delete;
+
+    unsigned int size() const { return m_entities.size(); }
+
+    bool contains(unsigned int entity) const { return m_positions.get(entity) != -1; }
+
+    const std::vector<entity_type> &getEntities() const { return m_entities; }
+
+    template <typename ComponentType>
+    ComponentType &get(unsigned int entity) const
+    {
+        return std::get<component_table<ComponentType, Config> *>(m_tables)->get(entity);
+    }
+
+    // calls func(entity, components...) for every entity in the group
+    template <typename Func>
+    void each(Func func) const
+    {
+        for (unsigned int entity : m_entities)
+        {
+            func(entity, get<ComponentTypes>(entity)...);
+        }
+    }
+};
+
+template <typename... ComponentTypes>
+using Group = BasicGroup<entity_config32, ComponentTypes...>;
+} // namespace Engine
+
+#endif
\ No newline at end of file
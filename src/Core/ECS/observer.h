@@ -0,0 +1,140 @@
+#ifndef CORE_ECS_OBSERVER
+#define CORE_ECS_OBSERVER
+
+#include "componentTable.h"
+#include "sparseArray.h"
+#include "view.h"
+#include <tuple>
+#include <vector>
+
+namespace Engine
+{
+// collects the entities that started or stopped owning a component of every given type so a system can handle them
+// once per frame instead of reacting to every callback; every entity is collected at most once per list
+template <typename Config, typename... ComponentTypes>
+class BasicObserver
+{
+private:
+    using positions_type = PagedSparseArray<typename Config::index_type>;
+
+    std::tuple<component_table<ComponentTypes, Config> *...> m_tables;
+    // entities that started to match since the last drain
+    std::vector<unsigned int> m_entered{};
+    positions_type m_enteredPositions{-1};
+    // entities that matched at the last drain and stopped matching since
+    std::vector<unsigned int> m_left{};
+    positions_type m_leftPositions{-1};
+    // keeps the callbacks into the tables connected
+    std::vector<Connection> m_callbacks{};
+
+    static void insert(std::vector<unsigned int> &entities, positions_type &positions, unsigned int entity)
+    {
+        if (positions.get(entity) == -1)
+        {
+            positions.set(entity, entities.size());
+            entities.push_back(entity);
+        }
+    }
+
+    static bool erase(std::vector<unsigned int> &entities, positions_type &positions, unsigned int entity)
+    {
+        int position = positions.get(entity);
+        if (position == -1)
+        {
+            return false;
+        }
+
+        unsigned int lastEntity = entities.back();
+        entities[position] = lastEntity;
+        positions.set(lastEntity, position);
+        entities.pop_back();
+        positions.set(entity, -1);
+
+        return true;
+    }
+
+    bool matches(unsigned int entity) const
+    {
+        return (std::get<component_table<ComponentTypes, Config> *>(m_tables)->contains(entity) && ...);
+    }
+
+    template <typename ComponentType>
+    void track(component_table<ComponentType, Config> *table)
+    {
+        using weak_pointer = typename component_table<ComponentType, Config>::weak_pointer;
+
+        m_callbacks.push_back(table->onAdded(
+            [this](unsigned int entity, weak_pointer)
+            {
+                if (matches(entity))
+                {
+                    insert(m_entered, m_enteredPositions, entity);
+                }
+            }));
+        // remove callbacks are called before the component is removed
+        m_callbacks.push_back(table->onRemove(
+            [this](unsigned int entity, weak_pointer)
+            {
+                // entities that entered and left between two drains are never seen by the system
+                if (matches(entity) && !erase(m_entered, m_enteredPositions, entity))
+                {
+                    insert(m_left, m_leftPositions, entity);
+                }
+            }));
+    }
+
+public:
+    // entities that already match count as entered
+    BasicObserver(component_table<ComponentTypes, Config> *...tables) : m_tables{tables...}
+    {
+        (track(tables), ...);
+
+        BasicView<Config, ComponentTypes...>{tables...}.each([this](unsigned int entity, ComponentTypes &...)
+                                                             { insert(m_entered, m_enteredPositions, entity); });
+    }
+
+    // the callbacks reference the observer
+    BasicObserver(const BasicObserver &other) = delete;
+
+    const std::vector<unsigned int> &getEntered() const { return m_entered; }
+
+    const std::vector<unsigned int> &getLeft() const { return m_left; }
+
+    bool empty() const { return m_entered.empty() && m_left.empty(); }
+
+    // hands the collected entities to the functions (the ones that left first) and clears the lists
+    // changes made by the functions are collected for the next drain
+    template <typename LeftFunc, typename EnteredFunc>
+    void drain(LeftFunc onLeft, EnteredFunc onEntered)
+    {
+        std::vector<unsigned int> left{};
+        std::vector<unsigned int> entered{};
+        left.swap(m_left);
+        entered.swap(m_entered);
+        m_leftPositions.clear();
+        m_enteredPositions.clear();
+
+        for (unsigned int entity : left)
+        {
+            onLeft(entity);
+        }
+        for (unsigned int entity : entered)
+        {
+            onEntered(entity);
+        }
+    }
+
+    void clear()
+    {
+        m_entered.clear();
+        m_left.clear();
+        m_enteredPositions.clear();
+        m_leftPositions.clear();
+    }
+};
+
+template <typename... ComponentTypes>
+using Observer = BasicObserver<entity_config32, ComponentTypes...>;
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -2,105 +2,507 @@
 #define CORE_ECS_REGISTRY
 
 #include "componentTable.h"
+#include "frozenRegistry.h"
+#include "group.h"
+#include "observer.h"
+#include "snapshot.h"
 #include "util.h"
+#include "view.h"
+#include <algorithm>
+#include <functional>
 #include <list>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace Engine
 {
-class Registry
+// entity id paired with the generation it was handed out in; the handle turns invalid once the entity is removed even
+// if its id gets reused
+struct EntityHandle
 {
+    unsigned int id;
+    unsigned int generation;
+
+    bool operator==(const EntityHandle &other) const { return id == other.id && generation == other.generation; }
+    bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+#ifndef NDEBUG
+// component types the system running on the current thread declared; the scheduler sets them in debug builds so
+// accesses to other types (which could race with other systems) throw
+struct declared_components
+{
+    static const std::vector<unsigned int> *&current()
+    {
+        thread_local const std::vector<unsigned int> *types{nullptr};
+        return types;
+    }
+};
+#endif
+
+// overview over a registry (see BasicRegistry::stats)
+struct RegistryStats
+{
+    std::size_t numEntities{0};
+    // ids handed out so far (the sparse arrays grow with the largest id)
+    std::size_t maxEntities{0};
+    std::size_t numQueuedUpdates{0};
+    std::vector<ComponentTableStats> tables{};
+};
+
+// registry over a set of component types known at compile time; their tables live in a tuple and are found without a
+// lookup while tables for all other types are created on first use
+// the config picks the integer types of entity ids and component indices (see entity_config)
+// Registry is the variant with 32 bit ids and without any predeclared types
+template <typename Config, typename... Components>
+class BasicRegistry
+{
+    static_assert(unique_types<Components...>::value, "component types can only be declared once");
+
+public:
+    using entity_type = typename Config::entity_type;
+
 private:
-    std::vector<void *> m_componentLinks{};
-    // ordered list of unused entity ids
-    std::list<unsigned int> m_freeEntityIds{};
+    template <typename ComponentType>
+    using table_type = component_table<ComponentType, Config>;
+
+    std::tuple<table_type<Components>...> m_tables{};
+
+    // tables of the component types that weren't declared (indexed by type_index)
+    std::vector<std::shared_ptr<void>> m_componentLinks{};
+    // stack of unused entity ids (the last removed id is reused first)
+    std::vector<entity_type> m_freeEntityIds{};
     // ordered list of used entities
-    std::list<unsigned int> m_usedEntityIds{};
+    std::list<entity_type> m_usedEntityIds{};
+    // position of every entity inside m_usedEntityIds (m_usedEntityIds.end() for unused ids)
+    std::vector<typename std::list<entity_type>::iterator> m_usedEntityPositions{};
+    // increased every time an entity is removed
+    std::vector<unsigned int> m_entityGenerations{};
     unsigned int m_maxEntities = 0;
 
     std::vector<std::function<void(unsigned int)>> m_componentLinkCleaners{};
-    std::vector<std::function<void()>> m_componentLinkDeleters{};
+    // invokes the update callbacks of one component type for an entity
+    std::vector<std::function<void(unsigned int)>> m_componentLinkUpdaters{};
+    // returns the stats of one table and resets its event counts if asked to (empty for types without a table)
+    std::vector<std::function<ComponentTableStats(bool)>> m_componentLinkStats{};
+
+    bool m_deferUpdates{false};
+    // updates that are dispatched on the next flush (component type index and entity in the order of the first update)
+    std::vector<std::pair<unsigned int, EntityHandle>> m_queuedUpdates{};
+    // component type index and entity of every queued update to coalesce repeated updates
+    std::unordered_set<unsigned long long> m_queuedUpdateKeys{};
+
+    // groups are created on first request and then kept up to date by the tables they are based on
+    std::vector<std::shared_ptr<void>> m_groups{};
+
+    template <typename ComponentType>
+    table_type<ComponentType> *ensureComponentTable()
+    {
+#ifndef NDEBUG
+        if (const std::vector<unsigned int> *declared = declared_components::current())
+        {
+            if (std::find(declared->begin(), declared->end(), type_index<ComponentType>::value()) == declared->end())
+            {
+                throw "Component type wasn't declared by the system accessing it!";
+            }
+        }
+#endif
+
+        if constexpr (is_one_of<ComponentType, Components...>::value)
+        {
+            return &std::get<table_type<ComponentType>>(m_tables);
+        }
+        else
+        {
+            if (type_index<ComponentType>::value() >= m_componentLinks.size())
+            {
+                m_componentLinks.resize(type_index<ComponentType>::value() + 1, nullptr);
+                m_componentLinkCleaners.resize(type_index<ComponentType>::value() + 1,
+                                               [](unsigned int foo) { (void)foo; });
+                m_componentLinkUpdaters.resize(type_index<ComponentType>::value() + 1,
+                                               [](unsigned int foo) { (void)foo; });
+                m_componentLinkStats.resize(type_index<ComponentType>::value() + 1);
+            }
+
+            if (m_componentLinks[type_index<ComponentType>::value()] == nullptr)
+            {
+                m_componentLinks[type_index<ComponentType>::value()] = std::make_shared<table_type<ComponentType>>();
+                m_componentLinkCleaners[type_index<ComponentType>::value()] = [this](unsigned int entity)
+                { this->removeComponent<ComponentType>(entity); };
+                m_componentLinkUpdaters[type_index<ComponentType>::value()] = [this](unsigned int entity)
+                { this->dispatchUpdate<ComponentType>(entity); };
+                m_componentLinkStats[type_index<ComponentType>::value()] = [this](bool reset)
+                { return this->tableStats<ComponentType>(reset); };
+            }
+
+            return static_cast<table_type<ComponentType> *>(
+                m_componentLinks[type_index<ComponentType>::value()].get());
+        }
+    }
+
+    template <typename ComponentType>
+    void dispatchUpdate(unsigned int entity)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        // the component might have been removed since the update was queued
+        if (compTable->contains(entity))
+        {
+            compTable->updated(entity);
+        }
+    }
+
+    template <typename ComponentType>
+    ComponentTableStats tableStats(bool reset)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        ComponentTableStats stats = compTable->stats();
+        if (reset)
+        {
+            compTable->resetStats();
+        }
+
+        return stats;
+    }
 
+    // makes the entity another owner of the component (if there is one)
     template <typename ComponentType>
-    ComponentTable<ComponentType> *ensureComponentTable()
+    void share(unsigned int entity, const component_pointer<ComponentType> &component)
+    {
+        if (component)
+        {
+            addComponent<ComponentType>(entity, component);
+        }
+    }
+
+    // format of the snapshots ("GESN" and a version)
+    static constexpr unsigned int snapshotMagic{0x4E534547};
+    static constexpr unsigned int snapshotVersion{2};
+
+    template <typename ComponentType>
+    void writeComponents(SnapshotWriter &writer)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        // guards against restoring with other types than the snapshot was taken with
+        writer.write(static_cast<unsigned int>(sizeof(ComponentType)));
+
+        if constexpr (std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            writer.writeVector(compTable->getEntities());
+        }
+        else
+        {
+            // every component is written once followed by all of its owners to keep shared components shared
+            const std::vector<std::list<entity_type>> &owners = compTable->getOwners();
+            writer.write(static_cast<unsigned int>(owners.size()));
+
+            unsigned int index{0};
+            compTable->each(
+                [&](ComponentType &component)
+                {
+                    snapshot_traits<ComponentType>::write(writer, component);
+                    writer.write(static_cast<unsigned int>(owners[index].size()));
+                    for (entity_type owner : owners[index])
+                    {
+                        writer.write(owner);
+                    }
+                    ++index;
+                });
+        }
+    }
+
+    // reads the header of a snapshot and returns the number of entities it holds
+    template <typename... ComponentTypes>
+    static unsigned int readSnapshotHeader(SnapshotReader &reader)
+    {
+        if (reader.read<unsigned int>() != snapshotMagic || reader.read<unsigned int>() != snapshotVersion)
+        {
+            throw "Not a snapshot of a registry!";
+        }
+        if (reader.read<unsigned int>() != sizeof(entity_type) ||
+            reader.read<unsigned int>() != sizeof...(ComponentTypes))
+        {
+            throw "Snapshot doesn't match the component types!";
+        }
+
+        return reader.read<unsigned int>();
+    }
+
+    // walks a whole snapshot without touching the registry so restore can fail before clearing anything
+    template <typename... ComponentTypes>
+    static void validateSnapshot(SnapshotReader reader)
+    {
+        unsigned int numEntities = readSnapshotHeader<ComponentTypes...>(reader);
+        std::vector<unsigned int> generations(numEntities);
+        reader.read(generations.data(), generations.size() * sizeof(unsigned int));
+
+        auto checkEntity = [numEntities](entity_type entity)
+        {
+            if (entity >= numEntities)
+            {
+                throw "Snapshot is corrupted!";
+            }
+        };
+
+        unsigned int numUsed = reader.read<unsigned int>();
+        for (unsigned int i = 0; i < numUsed; ++i)
+        {
+            checkEntity(reader.read<entity_type>());
+        }
+        for (entity_type entity : reader.readVector<entity_type>())
+        {
+            checkEntity(entity);
+        }
+
+        (validateComponents<ComponentTypes>(reader, checkEntity), ...);
+
+        if (!reader.done())
+        {
+            throw "Snapshot is corrupted!";
+        }
+    }
+
+    template <typename ComponentType, typename CheckEntity>
+    static void validateComponents(SnapshotReader &reader, CheckEntity &checkEntity)
     {
-        if (type_index<ComponentType>::value() >= m_componentLinks.size())
+        if (reader.read<unsigned int>() != sizeof(ComponentType))
         {
-            m_componentLinks.resize(type_index<ComponentType>::value() + 1, nullptr);
-            m_componentLinkCleaners.resize(type_index<ComponentType>::value() + 1, [](unsigned int foo) { (void)foo; });
-            m_componentLinkDeleters.resize(type_index<ComponentType>::value() + 1, []() {});
+            throw "Snapshot doesn't match the component types!";
         }
 
-        if (m_componentLinks[type_index<ComponentType>::value()] == nullptr)
+        if constexpr (std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            for (entity_type entity : reader.readVector<entity_type>())
+            {
+                checkEntity(entity);
+            }
+        }
+        else
+        {
+            unsigned int numComponents = reader.read<unsigned int>();
+            for (unsigned int i = 0; i < numComponents; ++i)
+            {
+                snapshot_traits<ComponentType>::read(reader);
+                unsigned int numOwners = reader.read<unsigned int>();
+                for (unsigned int j = 0; j < numOwners; ++j)
+                {
+                    checkEntity(reader.read<entity_type>());
+                }
+            }
+        }
+    }
+
+    template <typename ComponentType>
+    void readComponents(SnapshotReader &reader)
+    {
+        // the size tag was checked by validateSnapshot
+        reader.read<unsigned int>();
+
+        if constexpr (std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            std::vector<entity_type> entities = reader.readVector<entity_type>();
+            createComponents<ComponentType>(std::vector<unsigned int>(entities.begin(), entities.end()));
+        }
+        else
         {
-            m_componentLinks[type_index<ComponentType>::value()] = new ComponentTable<ComponentType>{m_maxEntities};
-            m_componentLinkCleaners[type_index<ComponentType>::value()] = [&](unsigned int entity)
-            { this->removeComponent<ComponentType>(entity); };
-            m_componentLinkDeleters[type_index<ComponentType>::value()] = [this]()
-            { delete (ComponentTable<ComponentType> *)this->m_componentLinks[type_index<ComponentType>::value()]; };
+            unsigned int numComponents = reader.read<unsigned int>();
+            for (unsigned int i = 0; i < numComponents; ++i)
+            {
+                ComponentType component{snapshot_traits<ComponentType>::read(reader)};
+                unsigned int numOwners = reader.read<unsigned int>();
+
+                component_pointer<ComponentType> stored{};
+                for (unsigned int j = 0; j < numOwners; ++j)
+                {
+                    unsigned int owner = reader.read<entity_type>();
+                    if (j == 0)
+                    {
+                        stored = createComponent<ComponentType>(owner, std::move(component));
+                    }
+                    else
+                    {
+                        addComponent<ComponentType>(owner, stored);
+                    }
+                }
+            }
         }
+    }
 
-        return (ComponentTable<ComponentType> *)m_componentLinks[type_index<ComponentType>::value()];
+    // dispatches a queued update of any component type
+    void dispatchUpdate(unsigned int typeIndex, unsigned int entity)
+    {
+        bool declared = ((typeIndex == type_index<Components>::value() && (dispatchUpdate<Components>(entity), true)) ||
+                         ...);
+        if (!declared)
+        {
+            m_componentLinkUpdaters[typeIndex](entity);
+        }
     }
 
 public:
-    Registry() {}
-    Registry(const Registry &other) = delete;
+    BasicRegistry() {}
+    BasicRegistry(const BasicRegistry &other) = delete;
 
     unsigned int addEntity()
     {
         unsigned int freeIndex;
         if (!m_freeEntityIds.empty())
         {
-            freeIndex = m_freeEntityIds.front();
-            m_freeEntityIds.pop_front();
+            freeIndex = m_freeEntityIds.back();
+            m_freeEntityIds.pop_back();
         }
         else
         {
+            if (m_maxEntities >= Config::maxEntities)
+            {
+                throw "Ran out of entity ids!";
+            }
+
             freeIndex = m_maxEntities++;
+            m_usedEntityPositions.push_back(m_usedEntityIds.end());
+            m_entityGenerations.push_back(0);
         }
 
-        m_usedEntityIds.push_back(freeIndex);
+        m_usedEntityPositions[freeIndex] = m_usedEntityIds.insert(m_usedEntityIds.end(), freeIndex);
 
         return freeIndex;
     }
 
+    // creates count entities at once
+    std::vector<unsigned int> addEntities(unsigned int count)
+    {
+        std::vector<unsigned int> entities{};
+        entities.reserve(count);
+
+        if (count > m_freeEntityIds.size())
+        {
+            unsigned int newEntities = count - m_freeEntityIds.size();
+            m_usedEntityPositions.reserve(m_maxEntities + newEntities);
+            m_entityGenerations.reserve(m_maxEntities + newEntities);
+        }
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            entities.push_back(addEntity());
+        }
+
+        return entities;
+    }
+
     // returns a list of all used entity indices
-    const std::list<unsigned int> &getEntities() { return m_usedEntityIds; }
+    const std::list<entity_type> &getEntities() { return m_usedEntityIds; }
+
+    bool isAlive(unsigned int entity) const
+    {
+        return entity < m_maxEntities && m_usedEntityPositions[entity] != m_usedEntityIds.end();
+    }
+
+    // false once the entity the handle was created for is removed
+    bool isAlive(EntityHandle handle) const
+    {
+        return isAlive(handle.id) && m_entityGenerations[handle.id] == handle.generation;
+    }
 
+    EntityHandle getHandle(unsigned int entity) const
+    {
+        if (!isAlive(entity))
+        {
+            throw "Can't create a handle for an unused entity!";
+        }
+
+        return EntityHandle{entity, m_entityGenerations[entity]};
+    }
+
+    // creates count instances of the prefab entity which share its components of the given types (the heavy ones like
+    // geometries and materials); writes should go through getUniqueComponent so an instance gets its own copy first
+    // components an instance needs for itself (e.g. its transform) are added afterwards as usual
+    template <typename... SharedTypes>
+    std::vector<unsigned int> instantiate(unsigned int prefab, unsigned int count)
+    {
+        if (!isAlive(prefab))
+        {
+            throw "Can't instantiate an unused entity!";
+        }
+
+        std::tuple<component_pointer<SharedTypes>...> components{getComponent<SharedTypes>(prefab)...};
+        std::vector<unsigned int> instances = addEntities(count);
+
+        for (unsigned int instance : instances)
+        {
+            (share<SharedTypes>(instance, std::get<component_pointer<SharedTypes>>(components)), ...);
+        }
+
+        return instances;
+    }
+
+    // removing an unused entity does nothing
     void removeEntity(unsigned int index)
     {
+        if (!isAlive(index))
+        {
+            return;
+        }
+
+        (removeComponent<Components>(index), ...);
         for (std::function<void(unsigned int)> &cleaner : m_componentLinkCleaners)
         {
             cleaner(index);
         }
-        m_freeEntityIds.remove(index);
-        m_usedEntityIds.remove(index);
-        m_freeEntityIds.push_front(index);
+
+        m_usedEntityIds.erase(m_usedEntityPositions[index]);
+        m_usedEntityPositions[index] = m_usedEntityIds.end();
+        ++m_entityGenerations[index];
+        m_freeEntityIds.push_back(index);
     }
 
     template <typename ComponentType, typename... Args>
-    std::shared_ptr<ComponentType> createComponent(unsigned int entityId, Args &&...args)
+    component_pointer<ComponentType> createComponent(unsigned int entityId, Args &&...args)
     {
         if (entityId >= m_maxEntities)
         {
             throw "EntityId out of bounds\n";
         }
 
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->createComponent(entityId, std::forward<Args>(args)...);
     }
 
+    // creates a component from the same arguments for every given entity; add callbacks are invoked after all
+    // components are created followed by one invocation of the onAddedRange callbacks
+    template <typename ComponentType, typename... Args>
+    std::vector<component_pointer<ComponentType>> createComponents(const std::vector<unsigned int> &entityIds,
+                                                                   const Args &...args)
+    {
+        for (unsigned int entityId : entityIds)
+        {
+            if (entityId >= m_maxEntities)
+            {
+                throw "EntityId out of bounds\n";
+            }
+        }
+
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->createComponents(entityIds, args...);
+    }
+
     template <typename ComponentType>
-    std::shared_ptr<ComponentType> addComponent(unsigned int entityId, std::weak_ptr<ComponentType> component)
+    component_pointer<ComponentType> addComponent(unsigned int entityId,
+                                                  weak_component_pointer<ComponentType> component)
     {
         if (entityId >= m_maxEntities)
         {
             throw "EntityId out of bounds\n";
         }
 
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->addComponent(entityId, component);
     }
@@ -113,24 +515,64 @@ public:
             throw "EntityId out of bounds\n";
         }
 
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->hasComponent(entityId);
     }
 
     template <typename ComponentType>
-    std::shared_ptr<ComponentType> getComponent(unsigned int entityId)
+    component_pointer<ComponentType> getComponent(unsigned int entityId)
     {
         if (entityId >= m_maxEntities)
         {
             throw "EntityId out of bounds\n";
         }
 
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->getComponent(entityId);
     }
 
+    // returns the component of the entity for writing: a component that is shared with other entities is copied first
+    // so only the entity sees the change (copy on write for prefab instances; the swap callbacks are invoked for the
+    // copy); returns nullptr if the entity doesn't own a component of the type
+    template <typename ComponentType>
+    component_pointer<ComponentType> getUniqueComponent(unsigned int entityId)
+    {
+        if (entityId >= m_maxEntities)
+        {
+            throw "EntityId out of bounds\n";
+        }
+
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        if constexpr (!std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            if (compTable->contains(entityId) && compTable->getOwners(entityId).size() > 1)
+            {
+                // copied out first since creating the copy might move the stored components
+                ComponentType copy{compTable->get(entityId)};
+                return compTable->createComponent(entityId, std::move(copy));
+            }
+        }
+
+        return compTable->getComponent(entityId);
+    }
+
+    // like getComponent but returns a plain reference without touching reference counts (for hot read paths)
+    template <typename ComponentType>
+    ComponentRef<ComponentType> getComponentRef(unsigned int entityId)
+    {
+        if (entityId >= m_maxEntities)
+        {
+            throw "EntityId out of bounds\n";
+        }
+
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->getRef(entityId);
+    }
+
     template <typename ComponentType>
     void removeComponent(unsigned int entityId)
     {
@@ -139,118 +581,275 @@ public:
             throw "EntityId out of bounds\n";
         }
 
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         compTable->removeComponent(entityId);
     }
 
     template <typename ComponentType>
-    const std::vector<std::shared_ptr<ComponentType>> getComponents()
+    const std::vector<component_pointer<ComponentType>> getComponents()
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->getComponents();
     }
 
+    // iterates over all entities that own every one of the given component types
+    template <typename... ComponentTypes>
+    BasicView<Config, ComponentTypes...> view()
+    {
+        return BasicView<Config, ComponentTypes...>{ensureComponentTable<ComponentTypes>()...};
+    }
+
+    // visits every component of a specific type once without touching reference counts
+    template <typename ComponentType, typename Func>
+    void each(Func func)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        compTable->each(func);
+    }
+
+    // returns the packed list of all entities that own a component of a specific type
+    template <typename ComponentType>
+    const std::vector<entity_type> &getEntities()
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->getEntities();
+    }
+
     // returns all owners for all components of a specific type
     template <typename ComponentType>
-    const std::vector<std::list<unsigned int>> &getOwners()
+    const std::vector<std::list<entity_type>> &getOwners()
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->getOwners();
     }
 
     template <typename ComponentType>
-    const std::list<unsigned int> &getOwners(std::weak_ptr<ComponentType> component)
+    const std::list<entity_type> &getOwners(weak_component_pointer<ComponentType> component)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->getOwners(component);
     }
 
     template <typename ComponentType>
-    const std::list<unsigned int> &getOwners(unsigned int entity)
+    const std::list<entity_type> &getOwners(unsigned int entity)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
         return compTable->getOwners(entity);
     }
 
-    template <typename ComponentType>
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ComponentType>)>>
-    onAdded(std::function<void(unsigned int, std::weak_ptr<ComponentType>)> &&cb)
+    template <typename ComponentType, typename Func>
+    Connection onAdded(Func &&cb)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
-        return compTable->onAdded(std::move(cb));
+        return compTable->onAdded(std::forward<Func>(cb));
     }
 
-    template <typename ComponentType>
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ComponentType>)>>
-    onRemove(std::function<void(unsigned int, std::weak_ptr<ComponentType>)> &&cb)
+    template <typename ComponentType, typename Func>
+    Connection onAddedRange(Func &&cb)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->onAddedRange(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onRemove(Func &&cb)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->onRemove(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onUpdate(Func &&cb)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
-        return compTable->onRemove(std::move(cb));
+        return compTable->onUpdate(std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onUpdate(unsigned int entityId, Func &&cb)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->onUpdate(entityId, std::forward<Func>(cb));
+    }
+
+    template <typename ComponentType, typename Func>
+    Connection onComponentSwap(Func &&cb)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->onComponentSwap(std::forward<Func>(cb));
+    }
+
+    // creates the tables of the given types up front (e.g. before systems access them from several threads)
+    template <typename... ComponentTypes>
+    void ensureTables()
+    {
+        (ensureComponentTable<ComponentTypes>(), ...);
     }
 
     template <typename ComponentType>
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ComponentType>)>>
-    onUpdate(std::function<void(unsigned int, std::weak_ptr<ComponentType>)> &&cb)
+    void updated(unsigned int entity)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        if (m_deferUpdates && isAlive(entity))
+        {
+            unsigned int typeIndex{type_index<ComponentType>::value()};
+            // make sure the table (and its updater) exists when the queue is flushed
+            ensureComponentTable<ComponentType>();
+
+            if (m_queuedUpdateKeys.insert((static_cast<unsigned long long>(typeIndex) << 32) | entity).second)
+            {
+                m_queuedUpdates.emplace_back(typeIndex, getHandle(entity));
+            }
+            return;
+        }
 
-        return compTable->onUpdate(std::move(cb));
+        dispatchUpdate<ComponentType>(entity);
     }
 
+    // change tick of a component type; changes made after this call can later be queried through changedSince()
     template <typename ComponentType>
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ComponentType>)>>
-    onUpdate(unsigned int entityId, std::function<void(unsigned int, std::weak_ptr<ComponentType>)> &&cb)
+    unsigned long long getChangeTick()
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
-        return compTable->onUpdate(entityId, std::move(cb));
+        return compTable->getTick();
     }
 
+    // returns the entities whose component of the given type was added or updated after the given tick
+    // (lets systems that run once per frame pick up the changes instead of reacting to every update callback)
     template <typename ComponentType>
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ComponentType>)>>
-    onComponentSwap(std::function<void(unsigned int, std::weak_ptr<ComponentType>)> &&cb)
+    std::vector<unsigned int> changedSince(unsigned long long tick)
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
 
-        return compTable->onComponentSwap(std::move(cb));
+        return compTable->changedSince(tick);
     }
 
     template <typename ComponentType>
-    void updated(unsigned int entity)
+    bool changedSince(unsigned int entity, unsigned long long tick)
+    {
+        table_type<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+
+        return compTable->changedSince(entity, tick);
+    }
+
+    // queues calls to updated() instead of invoking the update callbacks right away; repeated updates of the same
+    // component on the same entity are only dispatched once by the next flushUpdates()
+    // (adding and removing components still invokes the callbacks immediately)
+    void deferUpdates() { m_deferUpdates = true; }
+
+    bool isDeferringUpdates() const { return m_deferUpdates; }
+
+    // stops deferring and dispatches the queued updates in the order they were first queued
+    // updates of removed components and entities are dropped; updates caused by the callbacks are dispatched directly
+    void flushUpdates()
     {
-        ComponentTable<ComponentType> *compTable = ensureComponentTable<ComponentType>();
+        m_deferUpdates = false;
 
-        compTable->updated(entity);
+        std::vector<std::pair<unsigned int, EntityHandle>> queuedUpdates{};
+        queuedUpdates.swap(m_queuedUpdates);
+        m_queuedUpdateKeys.clear();
+
+        for (const std::pair<unsigned int, EntityHandle> &update : queuedUpdates)
+        {
+            if (isAlive(update.second))
+            {
+                dispatchUpdate(update.first, update.second.id);
+            }
+        }
     }
 
+    // returns the persistent group of all entities owning every one of the given component types
+    template <typename... ComponentTypes>
+    BasicGroup<Config, ComponentTypes...> &group()
+    {
+        using group_type = BasicGroup<Config, ComponentTypes...>;
+
+        unsigned int groupIndex = type_index<group_type>::value();
+        if (groupIndex >= m_groups.size())
+        {
+            m_groups.resize(groupIndex + 1);
+        }
+
+        if (!m_groups[groupIndex])
+        {
+            m_groups[groupIndex] = std::make_shared<group_type>(ensureComponentTable<ComponentTypes>()...);
+        }
+
+        return *static_cast<group_type *>(m_groups[groupIndex].get());
+    }
+
+    // orders the components of the type with the comparator (called with two components) so iterating over the table
+    // or over views that use it for their candidates touches them in that order
+    template <typename ComponentType, typename Compare>
+    void sort(Compare compare)
+    {
+        static_assert(!std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value,
+                      "tags all compare equal; order them with sortAs");
+        ensureComponentTable<ComponentType>()->sort(compare);
+    }
+
+    // orders the components of type A like the entities that own a component of type B (entities without one come
+    // last) so both tables can be walked side by side
     template <typename TypeA, typename TypeB>
-    std::vector<std::pair<std::shared_ptr<TypeA>, std::vector<std::shared_ptr<TypeB>>>> getGroupedComponents()
+    void sortAs()
     {
-        std::vector<std::shared_ptr<TypeA>> aComponents = getComponents<TypeA>();
-        std::vector<std::list<unsigned int>> aOwners = getOwners<TypeA>();
+        ensureComponentTable<TypeA>()->sortAs(ensureComponentTable<TypeB>()->getEntities());
+    }
 
-        std::vector<std::pair<std::shared_ptr<TypeA>, std::vector<std::shared_ptr<TypeB>>>> out{};
+    // creates an observer collecting the entities that start or stop owning a component of every given type
+    // (every system owns its observers so each of them can drain them independently)
+    template <typename... ComponentTypes>
+    std::unique_ptr<BasicObserver<Config, ComponentTypes...>> observe()
+    {
+        return std::make_unique<BasicObserver<Config, ComponentTypes...>>(ensureComponentTable<ComponentTypes>()...);
+    }
+
+    // takes a read-only copy of the tables of the given types that worker threads can query while the registry is
+    // edited (has to be called from the thread editing the registry)
+    template <typename... ComponentTypes>
+    BasicFrozenRegistry<Config, ComponentTypes...> freeze()
+    {
+        return BasicFrozenRegistry<Config, ComponentTypes...>{ensureComponentTable<ComponentTypes>()...};
+    }
+
+    // groups all components of TypeA with the components of TypeB their owners have
+    // (group<TypeA, TypeB>() is the persistent alternative when the TypeA components themselves aren't needed)
+    template <typename TypeA, typename TypeB>
+    std::vector<std::pair<component_pointer<TypeA>, std::vector<component_pointer<TypeB>>>> getGroupedComponents()
+    {
+        table_type<TypeA> *aTable = ensureComponentTable<TypeA>();
+        table_type<TypeB> *bTable = ensureComponentTable<TypeB>();
+
+        std::vector<component_pointer<TypeA>> aComponents = aTable->getComponents();
+        const std::vector<std::list<entity_type>> &aOwners = aTable->getOwners();
+
+        std::vector<std::pair<component_pointer<TypeA>, std::vector<component_pointer<TypeB>>>> out{};
         out.reserve(aComponents.size());
 
         for (unsigned int i = 0; i < aComponents.size(); ++i)
         {
-            std::shared_ptr<TypeA> &component = aComponents[i];
-            std::vector<std::shared_ptr<TypeB>> associated{};
+            component_pointer<TypeA> &component = aComponents[i];
+            std::vector<component_pointer<TypeB>> associated{};
             associated.reserve(aOwners[i].size());
 
             for (unsigned int owner : aOwners[i])
             {
-                std::shared_ptr<TypeB> otherComponent = getComponent<TypeB>(owner);
-                if (otherComponent)
+                if (bTable->contains(owner))
                 {
-                    associated.push_back(otherComponent);
+                    associated.push_back(bTable->getComponent(owner));
                 }
             }
 
@@ -260,16 +859,109 @@ public:
         return out;
     }
 
+    // memory and event statistics of every component table (the declared ones first); the event counts are the ones
+    // since the last reset which is done right away if asked for (e.g. once per second for rates)
+    RegistryStats stats(bool reset = false)
+    {
+        RegistryStats stats{};
+        stats.numEntities = m_usedEntityIds.size();
+        stats.maxEntities = m_maxEntities;
+        stats.numQueuedUpdates = m_queuedUpdates.size();
+
+        (stats.tables.push_back(tableStats<Components>(reset)), ...);
+        for (std::function<ComponentTableStats(bool)> &tableStats : m_componentLinkStats)
+        {
+            if (tableStats)
+            {
+                stats.tables.push_back(tableStats(reset));
+            }
+        }
+
+        return stats;
+    }
+
     void clear()
     {
-        auto reverseIterator = m_usedEntityIds.rbegin();
+        while (!m_usedEntityIds.empty())
+        {
+            removeEntity(m_usedEntityIds.back());
+        }
+    }
+
+    // writes all entities (ids, generations and free ids included) and the components of the given types into a
+    // binary snapshot; the types need snapshot_traits (trivially copyable and empty types work out of the box)
+    template <typename... ComponentTypes>
+    std::string snapshot()
+    {
+        std::string data{};
+        SnapshotWriter writer{data};
 
-        while (reverseIterator != m_usedEntityIds.rend())
+        writer.write(snapshotMagic);
+        writer.write(snapshotVersion);
+        writer.write(static_cast<unsigned int>(sizeof(entity_type)));
+        writer.write(static_cast<unsigned int>(sizeof...(ComponentTypes)));
+
+        writer.writeVector(m_entityGenerations);
+        writer.write(static_cast<unsigned int>(m_usedEntityIds.size()));
+        for (entity_type entity : m_usedEntityIds)
+        {
+            writer.write(entity);
+        }
+        writer.writeVector(m_freeEntityIds);
+
+        (writeComponents<ComponentTypes>(writer), ...);
+
+        return data;
+    }
+
+    // replaces the content of the registry with a snapshot taken with the same component types in the same order
+    // the components are added through the usual functions so all callbacks are invoked like on a regular load
+    // the snapshot is validated first; a snapshot that doesn't match throws and leaves the registry untouched
+    template <typename... ComponentTypes>
+    void restore(const char *data, std::size_t size)
+    {
+        validateSnapshot<ComponentTypes...>(SnapshotReader{data, size});
+
+        SnapshotReader reader{data, size};
+        unsigned int numEntities = readSnapshotHeader<ComponentTypes...>(reader);
+
+        clear();
+        m_queuedUpdates.clear();
+        m_queuedUpdateKeys.clear();
+
+        m_maxEntities = numEntities;
+        m_entityGenerations.resize(m_maxEntities);
+        reader.read(m_entityGenerations.data(), m_entityGenerations.size() * sizeof(unsigned int));
+        m_usedEntityIds.clear();
+        m_usedEntityPositions.assign(m_maxEntities, m_usedEntityIds.end());
+        unsigned int numUsed = reader.read<unsigned int>();
+        for (unsigned int i = 0; i < numUsed; ++i)
         {
-            removeEntity(*reverseIterator);
+            entity_type entity = reader.read<entity_type>();
+            m_usedEntityPositions.at(entity) = m_usedEntityIds.insert(m_usedEntityIds.end(), entity);
         }
+        m_freeEntityIds = reader.readVector<entity_type>();
+
+        (readComponents<ComponentTypes>(reader), ...);
+    }
+
+    template <typename... ComponentTypes>
+    void restore(const std::string &data)
+    {
+        restore<ComponentTypes...>(data.data(), data.size());
     }
 };
+
+// registry that creates the tables of all component types on first use
+class Registry : public BasicRegistry<entity_config32>
+{
+public:
+    Registry() {}
+    Registry(const Registry &other) = delete;
+};
+
+// registry for small scenes with at most 32767 entities
+using SmallRegistry = BasicRegistry<entity_config16>;
 } // namespace Engine
 
 #endif
\ No newline at end of file
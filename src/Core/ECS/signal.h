@@ -0,0 +1,375 @@
+#ifndef CORE_ECS_SIGNAL
+#define CORE_ECS_SIGNAL
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+template <typename Signature, std::size_t BufferSize = 6 * sizeof(void *)>
+class SmallFunction;
+
+// move-only callable that stores small callables (e.g. lambdas capturing a few pointers) inline; bigger callables
+// fall back to a heap allocation
+template <typename R, typename... Args, std::size_t BufferSize>
+class SmallFunction<R(Args...), BufferSize>
+{
+private:
+    enum class Operation
+    {
+        move,
+        destroy
+    };
+
+    alignas(std::max_align_t) unsigned char m_buffer[BufferSize];
+    R (*m_invoke)(void *, Args...){nullptr};
+    void (*m_manage)(Operation, void *, void *){nullptr};
+
+    template <typename Func>
+    static constexpr bool storedInline()
+    {
+        return sizeof(Func) <= BufferSize && alignof(Func) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Func>::value;
+    }
+
+    template <typename Func>
+    static Func *target(void *buffer)
+    {
+        if constexpr (storedInline<Func>())
+        {
+            return std::launder(reinterpret_cast<Func *>(buffer));
+        }
+        else
+        {
+            return *reinterpret_cast<Func **>(buffer);
+        }
+    }
+
+    template <typename Func>
+    static R invoke(void *buffer, Args... args)
+    {
+        return (*target<Func>(buffer))(std::forward<Args>(args)...);
+    }
+
+    template <typename Func>
+    static void manage(Operation operation, void *buffer, void *other)
+    {
+        if (operation == Operation::destroy)
+        {
+            if constexpr (storedInline<Func>())
+            {
+                target<Func>(buffer)->~Func();
+            }
+            else
+            {
+                delete target<Func>(buffer);
+            }
+            return;
+        }
+
+        // move the callable from other into buffer
+        if constexpr (storedInline<Func>())
+        {
+            new (buffer) Func{std::move(*target<Func>(other))};
+            target<Func>(other)->~Func();
+        }
+        else
+        {
+            *reinterpret_cast<Func **>(buffer) = target<Func>(other);
+        }
+    }
+
+public:
+    SmallFunction() {}
+
+    template <typename Func, typename = std::enable_if_t<!std::is_same<std::decay_t<Func>, SmallFunction>::value>>
+    SmallFunction(Func &&func)
+    {
+        using stored_type = std::decay_t<Func>;
+
+        if constexpr (storedInline<stored_type>())
+        {
+            new (m_buffer) stored_type{std::forward<Func>(func)};
+        }
+        else
+        {
+            *reinterpret_cast<stored_type **>(m_buffer) = new stored_type{std::forward<Func>(func)};
+        }
+
+        m_invoke = &invoke<stored_type>;
+        m_manage = &manage<stored_type>;
+    }
+
+    SmallFunction(SmallFunction &&other) noexcept { *this = std::move(other); }
+
+    SmallFunction &operator=(SmallFunction &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.m_manage)
+            {
+                other.m_manage(Operation::move, m_buffer, other.m_buffer);
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+                other.m_invoke = nullptr;
+                other.m_manage = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    SmallFunction(const SmallFunction &other) = delete;
+    SmallFunction &operator=(const SmallFunction &other) = delete;
+
+    ~SmallFunction() { reset(); }
+
+    void reset()
+    {
+        if (m_manage)
+        {
+            m_manage(Operation::destroy, m_buffer, nullptr);
+            m_invoke = nullptr;
+            m_manage = nullptr;
+        }
+    }
+
+    explicit operator bool() const { return m_invoke != nullptr; }
+
+    R operator()(Args... args) { return m_invoke(m_buffer, std::forward<Args>(args)...); }
+};
+
+// identifies a connected callback inside its signal; ids of disconnected callbacks never match again even if the
+// slot is reused
+struct SlotId
+{
+    unsigned int slot;
+    unsigned int generation;
+};
+
+namespace detail
+{
+// the part of a signal connections need to be able to disconnect
+class SlotStorage
+{
+public:
+    virtual ~SlotStorage() {}
+    virtual void disconnect(SlotId id) = 0;
+    virtual bool connected(SlotId id) const = 0;
+};
+} // namespace detail
+
+// keeps a callback connected to a signal; the callback is disconnected when the connection is reset or destroyed
+// (connections can outlive their signal)
+class Connection
+{
+private:
+    std::weak_ptr<detail::SlotStorage> m_storage{};
+    SlotId m_id{0, 0};
+
+public:
+    Connection() {}
+    Connection(std::nullptr_t) {}
+    Connection(const std::weak_ptr<detail::SlotStorage> &storage, SlotId id) : m_storage{storage}, m_id{id} {}
+
+    Connection(Connection &&other) noexcept { *this = std::move(other); }
+
+    // assigning another connection disconnects the current callback
+    Connection &operator=(Connection &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_storage = std::move(other.m_storage);
+            m_id = other.m_id;
+            other.m_storage.reset();
+        }
+
+        return *this;
+    }
+
+    Connection(const Connection &other) = delete;
+    Connection &operator=(const Connection &other) = delete;
+
+    ~Connection() { reset(); }
+
+    void reset()
+    {
+        if (std::shared_ptr<detail::SlotStorage> storage = m_storage.lock())
+        {
+            storage->disconnect(m_id);
+        }
+        m_storage.reset();
+    }
+
+    bool connected() const
+    {
+        std::shared_ptr<detail::SlotStorage> storage = m_storage.lock();
+        return storage && storage->connected(m_id);
+    }
+
+    explicit operator bool() const { return connected(); }
+
+    SlotId id() const { return m_id; }
+};
+
+template <typename Signature>
+class Signal;
+
+// list of callbacks that are invoked in the order they were connected
+// callbacks can connect and disconnect (themselves included) while the signal is invoked; callbacks connected during
+// an invocation are first called by the next one
+template <typename... Args>
+class Signal<void(Args...)>
+{
+public:
+    using callback_type = SmallFunction<void(Args...)>;
+
+private:
+    class Slots : public detail::SlotStorage
+    {
+    public:
+        struct Slot
+        {
+            callback_type callback{};
+            // increased every time the slot is disconnected to invalidate old connections
+            unsigned int generation{0};
+            bool connected{false};
+        };
+
+        // a deque keeps references to the slots stable while callbacks connect new ones
+        std::deque<Slot> slots{};
+        std::vector<unsigned int> freeSlots{};
+        // slots that were disconnected during an invocation (their callbacks might still be running)
+        std::vector<unsigned int> pendingSlots{};
+        unsigned int invocationDepth{0};
+
+        void disconnect(SlotId id) override
+        {
+            if (!connected(id))
+            {
+                return;
+            }
+
+            slots[id.slot].connected = false;
+            ++slots[id.slot].generation;
+
+            if (invocationDepth > 0)
+            {
+                pendingSlots.push_back(id.slot);
+            }
+            else
+            {
+                slots[id.slot].callback.reset();
+                freeSlots.push_back(id.slot);
+            }
+        }
+
+        bool connected(SlotId id) const override
+        {
+            return id.slot < slots.size() && slots[id.slot].connected && slots[id.slot].generation == id.generation;
+        }
+    };
+
+    // frees disconnected slots once the outermost invocation is done (also when a callback throws)
+    class InvocationGuard
+    {
+    private:
+        Slots &m_slots;
+
+    public:
+        InvocationGuard(Slots &slots) : m_slots{slots} { ++m_slots.invocationDepth; }
+
+        ~InvocationGuard()
+        {
+            if (--m_slots.invocationDepth == 0)
+            {
+                for (unsigned int slot : m_slots.pendingSlots)
+                {
+                    m_slots.slots[slot].callback.reset();
+                    m_slots.freeSlots.push_back(slot);
+                }
+                m_slots.pendingSlots.clear();
+            }
+        }
+    };
+
+    std::shared_ptr<Slots> m_slots{std::make_shared<Slots>()};
+
+public:
+    Signal() {}
+    // connections point to the slots of this signal
+    Signal(const Signal &other) = delete;
+
+    template <typename Func>
+    Connection connect(Func &&func)
+    {
+        Slots &slots{*m_slots};
+
+        unsigned int slot;
+        // slots are only reused outside of invocations so new callbacks aren't called by a running invocation
+        if (!slots.freeSlots.empty() && slots.invocationDepth == 0)
+        {
+            slot = slots.freeSlots.back();
+            slots.freeSlots.pop_back();
+        }
+        else
+        {
+            slot = slots.slots.size();
+            slots.slots.emplace_back();
+        }
+
+        slots.slots[slot].callback = callback_type{std::forward<Func>(func)};
+        slots.slots[slot].connected = true;
+
+        return Connection{std::weak_ptr<detail::SlotStorage>{m_slots}, SlotId{slot, slots.slots[slot].generation}};
+    }
+
+    bool connected(SlotId id) const { return m_slots->connected(id); }
+
+    // disconnects the callback no matter which connection holds it
+    void disconnect(SlotId id) { m_slots->disconnect(id); }
+
+    bool invoking() const { return m_slots->invocationDepth > 0; }
+
+    // number of connected callbacks
+    std::size_t size() const
+    {
+        return m_slots->slots.size() - m_slots->freeSlots.size() - m_slots->pendingSlots.size();
+    }
+
+    void operator()(Args... args)
+    {
+        InvocationGuard guard{*m_slots};
+
+        std::deque<typename Slots::Slot> &slots{m_slots->slots};
+        std::size_t numSlots{slots.size()};
+        for (std::size_t i = 0; i < numSlots; ++i)
+        {
+            if (slots[i].connected)
+            {
+                slots[i].callback(args...);
+            }
+        }
+    }
+
+    // invokes a single callback if it is still connected
+    void invoke(SlotId id, Args... args)
+    {
+        InvocationGuard guard{*m_slots};
+
+        if (connected(id))
+        {
+            m_slots->slots[id.slot].callback(args...);
+        }
+    }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
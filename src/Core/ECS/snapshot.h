@@ -0,0 +1,124 @@
+#ifndef CORE_ECS_SNAPSHOT
+#define CORE_ECS_SNAPSHOT
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Engine
+{
+// appends values to a binary snapshot
+class SnapshotWriter
+{
+private:
+    std::string &m_data;
+
+public:
+    SnapshotWriter(std::string &data) : m_data{data} {}
+
+    void write(const void *data, std::size_t size)
+    {
+        // empty vectors may hand out nullptr
+        if (size == 0)
+        {
+            return;
+        }
+
+        m_data.append(static_cast<const char *>(data), size);
+    }
+
+    template <typename T>
+    void write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written directly");
+        write(&value, sizeof(T));
+    }
+
+    void writeString(const std::string &value)
+    {
+        write(static_cast<unsigned int>(value.size()));
+        write(value.data(), value.size());
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T> &values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written directly");
+        write(static_cast<unsigned int>(values.size()));
+        write(values.data(), values.size() * sizeof(T));
+    }
+};
+
+// reads values from a snapshot in memory in the order they were written
+class SnapshotReader
+{
+private:
+    const char *m_data;
+    std::size_t m_size;
+    std::size_t m_offset{0};
+
+public:
+    SnapshotReader(const char *data, std::size_t size) : m_data{data}, m_size{size} {}
+
+    void read(void *out, std::size_t size)
+    {
+        // empty vectors may hand out nullptr which memcpy doesn't accept even for zero bytes
+        if (size == 0)
+        {
+            return;
+        }
+        if (m_offset + size > m_size)
+        {
+            throw "Snapshot ended unexpectedly!";
+        }
+
+        std::memcpy(out, m_data + m_offset, size);
+        m_offset += size;
+    }
+
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read directly");
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    std::string readString()
+    {
+        std::string value(read<unsigned int>(), '\0');
+        read(&value[0], value.size());
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> readVector()
+    {
+        std::vector<T> values(read<unsigned int>());
+        read(values.data(), values.size() * sizeof(T));
+        return values;
+    }
+
+    bool done() const { return m_offset == m_size; }
+};
+
+// tells snapshots how to write and read a component type; component types opt in by specializing this struct with
+//   static void write(SnapshotWriter &writer, ComponentType &component)
+//   static ComponentType read(SnapshotReader &reader)
+// trivially copyable types are copied byte by byte
+template <typename ComponentType, typename = void>
+struct snapshot_traits;
+
+template <typename ComponentType>
+struct snapshot_traits<ComponentType, std::enable_if_t<std::is_trivially_copyable<ComponentType>::value>>
+{
+    static void write(SnapshotWriter &writer, ComponentType &component) { writer.write(component); }
+
+    static ComponentType read(SnapshotReader &reader) { return reader.read<ComponentType>(); }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
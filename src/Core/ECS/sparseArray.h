@@ -0,0 +1,90 @@
+#ifndef CORE_ECS_SPARSEARRAY
+#define CORE_ECS_SPARSEARRAY
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+// array indexed by entity ids that allocates fixed size pages on demand so its memory scales with the number of stored
+// values instead of the highest index; indices without a value (or inside missing pages) read as the empty value
+template <typename ValueType, unsigned int PageSize = 1024>
+class PagedSparseArray
+{
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize has to be a power of two");
+
+private:
+    std::vector<std::unique_ptr<ValueType[]>> m_pages{};
+    // number of non empty values inside each page (pages are freed once they are empty again)
+    std::vector<unsigned int> m_pageSizes{};
+    ValueType m_empty;
+
+public:
+    PagedSparseArray(ValueType empty) : m_empty{empty} {}
+
+    // never allocates (safe for concurrent readers)
+    ValueType get(unsigned int index) const
+    {
+        unsigned int page = index / PageSize;
+        return page < m_pages.size() && m_pages[page] ? m_pages[page][index % PageSize] : m_empty;
+    }
+
+    void set(unsigned int index, ValueType value)
+    {
+        unsigned int page = index / PageSize;
+        bool wasEmpty = get(index) == m_empty;
+        bool isEmpty = value == m_empty;
+
+        if (wasEmpty && isEmpty)
+        {
+            return;
+        }
+
+        if (page >= m_pages.size())
+        {
+            m_pages.resize(page + 1);
+            m_pageSizes.resize(page + 1, 0);
+        }
+
+        if (!m_pages[page])
+        {
+            m_pages[page] = std::make_unique<ValueType[]>(PageSize);
+            std::fill(m_pages[page].get(), m_pages[page].get() + PageSize, m_empty);
+        }
+
+        m_pages[page][index % PageSize] = value;
+
+        if (wasEmpty)
+        {
+            ++m_pageSizes[page];
+        }
+        else if (isEmpty && --m_pageSizes[page] == 0)
+        {
+            m_pages[page].reset();
+        }
+    }
+
+    // number of allocated pages
+    unsigned int getNumPages() const
+    {
+        unsigned int numPages{0};
+        for (const std::unique_ptr<ValueType[]> &page : m_pages)
+        {
+            numPages += page != nullptr;
+        }
+        return numPages;
+    }
+
+    // number of values the allocated pages can hold
+    std::size_t getCapacity() const { return static_cast<std::size_t>(getNumPages()) * PageSize; }
+
+    void clear()
+    {
+        m_pages.clear();
+        m_pageSizes.clear();
+    }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -1,7 +1,18 @@
 #ifndef CORE_ECS_UTIL
 #define CORE_ECS_UTIL
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <typeinfo>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 
 namespace Engine
 {
@@ -12,14 +23,66 @@ using void_t = void;
 // with limited C++ knowledge
 struct index_counter
 {
-    // returns the current index count and increases it
+    // returns the current index count and increases it (types can be seen for the first time on any thread)
     static unsigned int next()
     {
-        static unsigned int value{};
+        static std::atomic<unsigned int> value{};
         return value++;
     }
 };
 
+// true if T is one of the types in Ts
+template <typename T, typename... Ts>
+struct is_one_of : std::disjunction<std::is_same<T, Ts>...>
+{
+};
+
+// true if no type appears twice in Ts
+template <typename... Ts>
+struct unique_types : std::true_type
+{
+};
+
+template <typename T, typename... Ts>
+struct unique_types<T, Ts...> : std::bool_constant<!is_one_of<T, Ts...>::value && unique_types<Ts...>::value>
+{
+};
+
+// integer types a registry stores entity ids and the component indices of its sparse arrays in
+// smaller types halve the memory of the sparse arrays and entity lists but limit the number of entities
+template <typename EntityType, typename IndexType>
+struct entity_config
+{
+    static_assert(std::is_unsigned<EntityType>::value, "entity ids have to be unsigned");
+    static_assert(std::is_signed<IndexType>::value, "indices use -1 for entities without a component");
+
+    using entity_type = EntityType;
+    using index_type = IndexType;
+
+    // every entity has to fit into both types (there are never more components or owners than entities)
+    static constexpr unsigned long long maxEntities{
+        std::min<unsigned long long>(std::numeric_limits<EntityType>::max(), std::numeric_limits<IndexType>::max())};
+};
+
+using entity_config32 = entity_config<unsigned int, int>;
+using entity_config16 = entity_config<std::uint16_t, std::int16_t>;
+
+// readable name of a type for debug output (demangled where the compiler supports it)
+template <typename T>
+std::string type_name()
+{
+#ifdef __GNUG__
+    int status{0};
+    std::unique_ptr<char, void (*)(void *)> demangled{abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status),
+                                                     std::free};
+    if (status == 0 && demangled)
+    {
+        return demangled.get();
+    }
+#endif
+    return typeid(T).name();
+}
+
 template <typename ComponentType, typename = void>
 struct type_index
 {
@@ -32,4 +95,4 @@ struct type_index
 };
 } // namespace Engine
 
-#endif
+#endif
\ No newline at end of file
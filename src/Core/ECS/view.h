@@ -0,0 +1,116 @@
+#ifndef CORE_ECS_VIEW
+#define CORE_ECS_VIEW
+
+#include "componentTable.h"
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+namespace Engine
+{
+// iterates over all entities that own a component of every given type
+// the entities of the smallest table are used as candidates which are then checked against the other tables
+// components of the viewed types must not be added or removed while iterating
+template <typename Config, typename... ComponentTypes>
+class BasicView
+{
+private:
+    std::tuple<component_table<ComponentTypes, Config> *...> m_tables;
+    const std::vector<typename Config::entity_type> *m_candidates{nullptr};
+
+public:
+    class iterator
+    {
+    private:
+        const BasicView *m_view;
+        unsigned int m_index;
+
+        // skip all candidates that are missing one of the components
+        void findMatch()
+        {
+            while (m_index < m_view->m_candidates->size() && !m_view->contains((*m_view->m_candidates)[m_index]))
+            {
+                ++m_index;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::tuple<unsigned int, ComponentTypes &...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        iterator(const BasicView *view, unsigned int index) : m_view{view}, m_index{index} { findMatch(); }
+
+        value_type operator*() const
+        {
+            unsigned int entity = (*m_view->m_candidates)[m_index];
+            return value_type{entity, m_view->template get<ComponentTypes>(entity)...};
+        }
+
+        iterator &operator++()
+        {
+            ++m_index;
+            findMatch();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator current{*this};
+            ++(*this);
+            return current;
+        }
+
+        bool operator==(const iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const iterator &other) const { return m_index != other.m_index; }
+    };
+
+    BasicView(component_table<ComponentTypes, Config> *...tables) : m_tables{tables...}
+    {
+        m_candidates = &std::get<0>(m_tables)->getEntities();
+        (
+            [this](const std::vector<typename Config::entity_type> &entities)
+            {
+                if (entities.size() < m_candidates->size())
+                {
+                    m_candidates = &entities;
+                }
+            }(tables->getEntities()),
+            ...);
+    }
+
+    bool contains(unsigned int entity) const
+    {
+        return (std::get<component_table<ComponentTypes, Config> *>(m_tables)->contains(entity) && ...);
+    }
+
+    template <typename ComponentType>
+    ComponentType &get(unsigned int entity) const
+    {
+        return std::get<component_table<ComponentType, Config> *>(m_tables)->get(entity);
+    }
+
+    // calls func(entity, components...) for every matching entity
+    template <typename Func>
+    void each(Func func) const
+    {
+        for (unsigned int entity : *m_candidates)
+        {
+            if (contains(entity))
+            {
+                func(entity, get<ComponentTypes>(entity)...);
+            }
+        }
+    }
+
+    iterator begin() const { return iterator{this, 0}; }
+    iterator end() const { return iterator{this, static_cast<unsigned int>(m_candidates->size())}; }
+};
+
+template <typename... ComponentTypes>
+using View = BasicView<entity_config32, ComponentTypes...>;
+} // namespace Engine
+
+#endif
\ No newline at end of file
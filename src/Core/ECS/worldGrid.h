@@ -0,0 +1,535 @@
+#ifndef CORE_ECS_WORLDGRID
+#define CORE_ECS_WORLDGRID
+
+#include "commandBuffer.h"
+#include "registry.h"
+#include "snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+// coordinates of a cell of a world grid on the x-z plane
+struct CellCoord
+{
+    int x;
+    int z;
+
+    bool operator<(const CellCoord &other) const { return x < other.x || (x == other.x && z < other.z); }
+    bool operator==(const CellCoord &other) const { return x == other.x && z == other.z; }
+};
+
+// splits the streamed entities of a registry into square cells that are written into one chunk file each and are
+// loaded and unloaded depending on their distance to the camera
+// chunks are read and decoded into command buffers on worker threads; the registry is only touched by the thread
+// calling update() which submits the buffers of the chunks that are ready
+// every chunk holds the components of the given types (PositionType places an entity in a cell); components that
+// reference other entities by id can't be streamed since entities get new ids on every load
+template <typename PositionType, typename... ComponentTypes>
+class WorldGrid
+{
+    static_assert(is_one_of<PositionType, ComponentTypes...>::value, "the position has to be streamed as well");
+    static_assert(unique_types<ComponentTypes...>::value, "component types can only be streamed once");
+
+public:
+    // returns the x and z coordinate of a position
+    using locator = std::function<std::pair<float, float>(PositionType &)>;
+
+private:
+    enum class CellState
+    {
+        unloaded,
+        loading,
+        loaded
+    };
+
+    struct Cell
+    {
+        CellState state{CellState::unloaded};
+        // size of the chunk (used as the estimate of the memory the loaded cell takes)
+        std::size_t size{0};
+        std::vector<EntityHandle> entities{};
+        std::future<CommandBuffer> loading{};
+        // chunks are written on a worker thread which a later load of the cell has to wait for
+        std::shared_future<void> saving{};
+    };
+
+    // format of the chunks ("GECK" and a version)
+    static constexpr unsigned int chunkMagic{0x4B434547};
+    static constexpr unsigned int chunkVersion{1};
+
+    Registry &m_registry;
+    std::filesystem::path m_directory;
+    float m_cellSize;
+    locator m_locate;
+    std::map<CellCoord, Cell> m_cells{};
+    // cells that are loaded or being loaded
+    std::set<CellCoord> m_active{};
+    // cell of every loaded entity; the handle tells a reused id apart from the removed entity that had it before
+    struct TrackedEntity
+    {
+        EntityHandle handle;
+        CellCoord cell;
+    };
+    std::unordered_map<unsigned int, TrackedEntity> m_entityCells{};
+    // cells up to this distance (in cells) from the camera are loaded and cells further than the unload radius are
+    // unloaded (the gap keeps cells at the border from being loaded and unloaded over and over)
+    int m_loadRadius{1};
+    int m_unloadRadius{2};
+    std::size_t m_memoryBudget;
+    // sum of the chunk sizes of the active cells
+    std::size_t m_residentSize{0};
+
+    static int distance(CellCoord a, CellCoord b) { return std::max(std::abs(a.x - b.x), std::abs(a.z - b.z)); }
+
+    std::filesystem::path chunkPath(CellCoord cell) const
+    {
+        return m_directory / ("cell_" + std::to_string(cell.x) + "_" + std::to_string(cell.z) + ".chunk");
+    }
+
+    template <typename ComponentType>
+    void writeComponents(SnapshotWriter &writer,
+                         const std::vector<unsigned int> &entities,
+                         const std::unordered_map<unsigned int, unsigned int> &localIndices)
+    {
+        // guards against loading with other types than the chunk was written with
+        writer.write(static_cast<unsigned int>(sizeof(ComponentType)));
+
+        if constexpr (std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            std::vector<unsigned int> owners{};
+            for (unsigned int i = 0; i < entities.size(); ++i)
+            {
+                if (m_registry.hasComponent<ComponentType>(entities[i]))
+                {
+                    owners.push_back(i);
+                }
+            }
+            writer.writeVector(owners);
+        }
+        else
+        {
+            // a component shared inside the cell is written once with all of its owners in the cell (owners in other
+            // cells get their own copy)
+            std::vector<std::pair<unsigned int, std::vector<unsigned int>>> components{};
+            std::vector<bool> written(entities.size(), false);
+            for (unsigned int i = 0; i < entities.size(); ++i)
+            {
+                if (written[i] || !m_registry.hasComponent<ComponentType>(entities[i]))
+                {
+                    continue;
+                }
+
+                std::vector<unsigned int> owners{};
+                for (unsigned int owner : m_registry.getOwners<ComponentType>(entities[i]))
+                {
+                    auto localIndex = localIndices.find(owner);
+                    if (localIndex != localIndices.end())
+                    {
+                        owners.push_back(localIndex->second);
+                        written[localIndex->second] = true;
+                    }
+                }
+                components.emplace_back(i, std::move(owners));
+            }
+
+            writer.write(static_cast<unsigned int>(components.size()));
+            for (const std::pair<unsigned int, std::vector<unsigned int>> &component : components)
+            {
+                ComponentType &stored = *m_registry.getComponent<ComponentType>(entities[component.first]);
+                snapshot_traits<ComponentType>::write(writer, stored);
+                writer.writeVector(component.second);
+            }
+        }
+    }
+
+    template <typename ComponentType>
+    static void readComponents(SnapshotReader &reader,
+                               CommandBuffer &buffer,
+                               const std::vector<PendingEntity> &entities)
+    {
+        if (reader.read<unsigned int>() != sizeof(ComponentType))
+        {
+            throw "Chunk doesn't match the component types!";
+        }
+
+        if constexpr (std::is_same<typename storage_policy<ComponentType>::type, tag_storage>::value)
+        {
+            for (unsigned int owner : reader.readVector<unsigned int>())
+            {
+                buffer.createComponent<ComponentType>(entities.at(owner));
+            }
+        }
+        else
+        {
+            unsigned int numComponents = reader.read<unsigned int>();
+            for (unsigned int i = 0; i < numComponents; ++i)
+            {
+                ComponentType component{snapshot_traits<ComponentType>::read(reader)};
+                std::vector<unsigned int> owners = reader.readVector<unsigned int>();
+                if (owners.empty())
+                {
+                    continue;
+                }
+
+                buffer.createComponent<ComponentType>(entities.at(owners[0]), std::move(component));
+                for (unsigned int j = 1; j < owners.size(); ++j)
+                {
+                    buffer.shareComponent<ComponentType>(entities.at(owners[0]), entities.at(owners[j]));
+                }
+            }
+        }
+    }
+
+    // decodes a chunk without touching the registry (runs on a worker thread)
+    static CommandBuffer readChunk(const std::string &data)
+    {
+        SnapshotReader reader{data.data(), data.size()};
+
+        if (reader.read<unsigned int>() != chunkMagic || reader.read<unsigned int>() != chunkVersion)
+        {
+            throw "Not a chunk of a world grid!";
+        }
+        if (reader.read<unsigned int>() != sizeof...(ComponentTypes))
+        {
+            throw "Chunk doesn't match the component types!";
+        }
+
+        CommandBuffer buffer{};
+        std::vector<PendingEntity> entities(reader.read<unsigned int>(), PendingEntity{0});
+        for (PendingEntity &entity : entities)
+        {
+            entity = buffer.addEntity();
+        }
+
+        (readComponents<ComponentTypes>(reader, buffer, entities), ...);
+
+        return buffer;
+    }
+
+    void load(CellCoord coord, Cell &cell)
+    {
+        cell.state = CellState::loading;
+        m_active.insert(coord);
+        m_residentSize += cell.size;
+
+        cell.loading = std::async(std::launch::async,
+                                  [path = chunkPath(coord), saving = cell.saving]()
+                                  {
+                                      if (saving.valid())
+                                      {
+                                          saving.get();
+                                      }
+
+                                      std::ifstream file{path, std::ios::binary};
+                                      if (!file)
+                                      {
+                                          throw "Couldn't read the chunk of a cell!";
+                                      }
+                                      std::string data{std::istreambuf_iterator<char>{file},
+                                                       std::istreambuf_iterator<char>{}};
+
+                                      return readChunk(data);
+                                  });
+    }
+
+    // a chunk that can't be read leaves the cell unloaded (so it can be loaded again) before the error is rethrown
+    void finishLoading(CellCoord coord, Cell &cell)
+    {
+        std::vector<unsigned int> created{};
+        try
+        {
+            created = cell.loading.get().submit(m_registry);
+        }
+        catch (...)
+        {
+            cell.state = CellState::unloaded;
+            m_residentSize -= cell.size;
+            m_active.erase(coord);
+            throw;
+        }
+
+        for (unsigned int entity : created)
+        {
+            EntityHandle handle{m_registry.getHandle(entity)};
+            cell.entities.push_back(handle);
+            m_entityCells[entity] = TrackedEntity{handle, coord};
+        }
+        cell.state = CellState::loaded;
+    }
+
+    // writes the entities of the cell that are still alive into its chunk and removes them from the registry
+    void unload(CellCoord coord, Cell &cell)
+    {
+        std::vector<unsigned int> entities{};
+        std::unordered_map<unsigned int, unsigned int> localIndices{};
+        for (EntityHandle handle : cell.entities)
+        {
+            auto entityCell = m_entityCells.find(handle.id);
+            if (entityCell != m_entityCells.end() && entityCell->second.handle == handle)
+            {
+                m_entityCells.erase(entityCell);
+            }
+            if (m_registry.isAlive(handle))
+            {
+                localIndices.emplace(handle.id, entities.size());
+                entities.push_back(handle.id);
+            }
+        }
+
+        std::string data{};
+        SnapshotWriter writer{data};
+        writer.write(chunkMagic);
+        writer.write(chunkVersion);
+        writer.write(static_cast<unsigned int>(sizeof...(ComponentTypes)));
+        writer.write(static_cast<unsigned int>(entities.size()));
+        (writeComponents<ComponentTypes>(writer, entities, localIndices), ...);
+
+        for (unsigned int entity : entities)
+        {
+            m_registry.removeEntity(entity);
+        }
+
+        m_residentSize -= cell.size;
+        m_active.erase(coord);
+        cell.size = data.size();
+        cell.entities.clear();
+        cell.state = CellState::unloaded;
+
+        cell.saving = std::async(std::launch::async,
+                                 [path = chunkPath(coord), data = std::move(data)]()
+                                 {
+                                     std::ofstream file{path, std::ios::binary | std::ios::trunc};
+                                     file.write(data.data(), data.size());
+                                     if (!file)
+                                     {
+                                         throw "Couldn't write the chunk of a cell!";
+                                     }
+                                 })
+                          .share();
+    }
+
+    // unloads the loaded cell furthest from the center if it is further away than the given distance
+    bool unloadFurthest(CellCoord center, int minDistance)
+    {
+        CellCoord furthest{};
+        int furthestDistance{minDistance};
+        for (CellCoord coord : m_active)
+        {
+            if (m_cells.at(coord).state == CellState::loaded && distance(coord, center) > furthestDistance)
+            {
+                furthest = coord;
+                furthestDistance = distance(coord, center);
+            }
+        }
+
+        if (furthestDistance == minDistance)
+        {
+            return false;
+        }
+
+        unload(furthest, m_cells.at(furthest));
+        return true;
+    }
+
+public:
+    // chunks already in the directory become the unloaded cells of the grid
+    WorldGrid(Registry &registry,
+              const std::filesystem::path &directory,
+              float cellSize,
+              locator locate,
+              std::size_t memoryBudget)
+        : m_registry{registry}, m_directory{directory}, m_cellSize{cellSize}, m_locate{std::move(locate)},
+          m_memoryBudget{memoryBudget}
+    {
+        std::filesystem::create_directories(m_directory);
+
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{m_directory})
+        {
+            CellCoord coord{};
+            if (entry.path().extension() == ".chunk" &&
+                std::sscanf(entry.path().stem().string().c_str(), "cell_%d_%d", &coord.x, &coord.z) == 2)
+            {
+                m_cells[coord].size = entry.file_size();
+            }
+        }
+    }
+
+    // the callbacks of the registry may reference the grid through the loaded entities
+    WorldGrid(const WorldGrid &other) = delete;
+
+    void setRadius(int loadRadius, int unloadRadius)
+    {
+        if (loadRadius < 0 || unloadRadius < loadRadius)
+        {
+            throw "The unload radius can't be smaller than the load radius!";
+        }
+
+        m_loadRadius = loadRadius;
+        m_unloadRadius = unloadRadius;
+    }
+
+    void setMemoryBudget(std::size_t memoryBudget) { m_memoryBudget = memoryBudget; }
+
+    CellCoord cellOf(float x, float z) const
+    {
+        return CellCoord{static_cast<int>(std::floor(x / m_cellSize)), static_cast<int>(std::floor(z / m_cellSize))};
+    }
+
+    // adds an entity to the cell its position lies in; the cell has to be loaded unless it has no chunk yet
+    // (entities stay in their cell when they move until they are tracked again)
+    void track(unsigned int entity)
+    {
+        if (!m_registry.hasComponent<PositionType>(entity))
+        {
+            throw "Streamed entities need a position!";
+        }
+
+        std::pair<float, float> position{m_locate(*m_registry.getComponent<PositionType>(entity))};
+        CellCoord coord{cellOf(position.first, position.second)};
+
+        auto found = m_cells.find(coord);
+        if (found == m_cells.end())
+        {
+            found = m_cells.emplace(coord, Cell{}).first;
+            found->second.state = CellState::loaded;
+            m_active.insert(coord);
+        }
+        if (found->second.state != CellState::loaded)
+        {
+            throw "The cell of the entity isn't loaded!";
+        }
+
+        EntityHandle handle{m_registry.getHandle(entity)};
+        auto previous = m_entityCells.find(entity);
+        // an entry for another generation belongs to a removed entity whose id was reused
+        if (previous != m_entityCells.end() && previous->second.handle == handle)
+        {
+            if (previous->second.cell == coord)
+            {
+                return;
+            }
+
+            std::vector<EntityHandle> &entities = m_cells.at(previous->second.cell).entities;
+            entities.erase(std::remove(entities.begin(), entities.end(), handle), entities.end());
+        }
+
+        found->second.entities.push_back(handle);
+        m_entityCells[entity] = TrackedEntity{handle, coord};
+    }
+
+    // splits the given entities of a freshly loaded scene into cells and writes all cells into chunks
+    void partition(const std::vector<unsigned int> &entities)
+    {
+        for (unsigned int entity : entities)
+        {
+            track(entity);
+        }
+
+        unloadAll();
+    }
+
+    // loads the cells around the camera (closest first) while the memory budget allows it and unloads the ones that
+    // are too far away or have to make room for closer ones; the loaded chunks are added to the registry here
+    void update(float cameraX, float cameraZ)
+    {
+        CellCoord center{cellOf(cameraX, cameraZ)};
+
+        for (CellCoord coord : std::vector<CellCoord>(m_active.begin(), m_active.end()))
+        {
+            Cell &cell = m_cells.at(coord);
+            if (cell.state == CellState::loading && cell.loading.valid() &&
+                cell.loading.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+            {
+                finishLoading(coord, cell);
+            }
+            if (cell.state == CellState::loaded && distance(coord, center) > m_unloadRadius)
+            {
+                unload(coord, cell);
+            }
+        }
+
+        std::vector<CellCoord> missing{};
+        for (int x = center.x - m_loadRadius; x <= center.x + m_loadRadius; ++x)
+        {
+            for (int z = center.z - m_loadRadius; z <= center.z + m_loadRadius; ++z)
+            {
+                auto found = m_cells.find(CellCoord{x, z});
+                if (found != m_cells.end() && found->second.state == CellState::unloaded)
+                {
+                    missing.push_back(found->first);
+                }
+            }
+        }
+        std::stable_sort(missing.begin(),
+                         missing.end(),
+                         [center](CellCoord a, CellCoord b) { return distance(a, center) < distance(b, center); });
+
+        for (CellCoord coord : missing)
+        {
+            Cell &cell = m_cells.at(coord);
+            while (m_residentSize + cell.size > m_memoryBudget && unloadFurthest(center, distance(coord, center)))
+            {
+            }
+            if (m_residentSize + cell.size > m_memoryBudget)
+            {
+                break;
+            }
+
+            load(coord, cell);
+        }
+    }
+
+    // blocks until all cells that are being loaded are added to the registry
+    void finishLoading()
+    {
+        // a failing cell leaves the active cells
+        for (CellCoord coord : std::vector<CellCoord>(m_active.begin(), m_active.end()))
+        {
+            Cell &cell = m_cells.at(coord);
+            if (cell.state == CellState::loading && cell.loading.valid())
+            {
+                finishLoading(coord, cell);
+            }
+        }
+    }
+
+    // writes every cell into its chunk and removes the streamed entities from the registry
+    void unloadAll()
+    {
+        finishLoading();
+
+        for (CellCoord coord : std::vector<CellCoord>(m_active.begin(), m_active.end()))
+        {
+            unload(coord, m_cells.at(coord));
+        }
+    }
+
+    bool isLoaded(CellCoord coord) const
+    {
+        auto found = m_cells.find(coord);
+        return found != m_cells.end() && found->second.state == CellState::loaded;
+    }
+
+    const std::vector<EntityHandle> &getEntities(CellCoord coord) const { return m_cells.at(coord).entities; }
+
+    // estimated memory of the loaded cells and the ones being loaded
+    std::size_t getResidentSize() const { return m_residentSize; }
+};
+} // namespace Engine
+
+#endif
\ No newline at end of file
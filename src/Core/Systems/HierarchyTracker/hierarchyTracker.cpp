@@ -14,11 +14,7 @@ Engine::Systems::HierarchyTracker::HierarchyTracker(Registry &registry) : m_regi
             {
                 m_entityData.emplace(
                     entity,
-                    meta_data{-1,
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<HierarchyComponent>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<HierarchyComponent>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>{}});
+                    meta_data{-1, Connection{}, Connection{}, Connection{}, Connection{}});
 
                 associate(entity);
             }
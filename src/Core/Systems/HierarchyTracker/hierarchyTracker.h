@@ -1,6 +1,7 @@
 #ifndef ENGINE_CORE_SYSTEMS_HIERARCHYTRACKER
 #define ENGINE_CORE_SYSTEMS_HIERARCHYTRACKER
 
+#include "../../ECS/signal.h"
 #include <functional>
 #include <map>
 #include <memory>
@@ -24,24 +25,14 @@ private:
     Registry &m_registry;
 
     // holds callback that gets called when a new hierarchy is added
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<HierarchyComponent> hierarchy)>> m_AddHierarchyCB{};
-
-    using meta_data = std::tuple<
-        int, // the currently assigned parent node
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<HierarchyComponent>)>>, // callback for when
-                                                                                               // the entity has a
-                                                                                               // hierarchy update
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<HierarchyComponent>)>>, // callback for when
-                                                                                               // the entity has its
-                                                                                               // hierarchy removed
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>, // callback for when
-                                                                                               // the entity has a
-                                                                                               // transform added or
-                                                                                               // updated
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>  // callback for when
-                                                                                               // the entity has its
-                                                                                               // transform removed
-        >;
+    Connection m_AddHierarchyCB{};
+
+    using meta_data = std::tuple<int,        // the currently assigned parent node
+                                 Connection, // callback for when the entity has a hierarchy update
+                                 Connection, // callback for when the entity has its hierarchy removed
+                                 Connection, // callback for when the entity has a transform added or updated
+                                 Connection  // callback for when the entity has its transform removed
+                                 >;
 
     std::map<unsigned int, meta_data> m_entityData{};
 
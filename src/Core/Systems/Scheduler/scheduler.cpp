@@ -0,0 +1,219 @@
+#include "scheduler.h"
+
+#include <algorithm>
+
+Engine::Systems::Scheduler::Scheduler(Registry &registry, int numThreads) : m_registry{registry}
+{
+    if (numThreads < 0)
+    {
+        numThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+    }
+
+    m_workers.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+    {
+        m_workers.emplace_back(&Scheduler::work, this, i + 1);
+    }
+}
+
+Engine::Systems::Scheduler::~Scheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stopping = true;
+    }
+    m_stateChanged.notify_all();
+
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void Engine::Systems::Scheduler::add(System &&system)
+{
+    system.numDependencies = 0;
+
+    // a new system waits for every earlier system it conflicts with
+    unsigned int index = m_systems.size();
+    for (System &other : m_systems)
+    {
+        if (conflict(other, system))
+        {
+            other.dependents.push_back(index);
+            ++system.numDependencies;
+        }
+    }
+
+    m_systems.push_back(std::move(system));
+}
+
+bool Engine::Systems::Scheduler::conflict(const System &a, const System &b) const
+{
+    auto writesTo = [](const System &writer, const std::vector<unsigned int> &types)
+    {
+        for (unsigned int type : writer.writes)
+        {
+            if (std::find(types.begin(), types.end(), type) != types.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    return writesTo(a, b.reads) || writesTo(a, b.writes) || writesTo(b, a.reads);
+}
+
+void Engine::Systems::Scheduler::run()
+{
+    for (System &system : m_systems)
+    {
+        system.prepare(m_registry);
+    }
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    m_report = FrameReport{};
+    m_report.systems.resize(m_systems.size());
+    m_remainingDependencies.resize(m_systems.size());
+    m_finished = 0;
+    m_error = nullptr;
+    m_frameStart = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < m_systems.size(); ++i)
+    {
+        m_remainingDependencies[i] = m_systems[i].numDependencies;
+        if (m_remainingDependencies[i] == 0)
+        {
+            makeReady(i);
+        }
+    }
+    m_stateChanged.notify_all();
+
+    // the calling thread works on the systems as well and is the only one running main thread systems
+    while (m_finished < m_systems.size())
+    {
+        m_stateChanged.wait(lock,
+                            [this]()
+                            { return m_finished == m_systems.size() || !m_readyMain.empty() || !m_ready.empty(); });
+
+        if (m_finished == m_systems.size())
+        {
+            break;
+        }
+
+        std::deque<unsigned int> &queue = m_readyMain.empty() ? m_ready : m_readyMain;
+        unsigned int system = queue.front();
+        queue.pop_front();
+
+        lock.unlock();
+        execute(system, 0);
+        lock.lock();
+    }
+
+    m_report.frameTime =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+
+    lock.unlock();
+
+    // the sync point for the structural changes of this frame
+    for (System &system : m_systems)
+    {
+        system.commands.submit(m_registry);
+    }
+
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void Engine::Systems::Scheduler::work(unsigned int thread)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    while (true)
+    {
+        m_stateChanged.wait(lock, [this]() { return m_stopping || !m_ready.empty(); });
+
+        if (m_stopping)
+        {
+            return;
+        }
+
+        unsigned int system = m_ready.front();
+        m_ready.pop_front();
+
+        lock.unlock();
+        execute(system, thread);
+        lock.lock();
+    }
+}
+
+void Engine::Systems::Scheduler::execute(unsigned int system, unsigned int thread)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::exception_ptr error{};
+#ifndef NDEBUG
+    declared_components::current() = &m_systems[system].declared;
+#endif
+    try
+    {
+        m_systems[system].run(m_registry, m_systems[system].commands);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+#ifndef NDEBUG
+    declared_components::current() = nullptr;
+#endif
+
+    auto end = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        SystemTiming &timing = m_report.systems[system];
+        timing.name = m_systems[system].name;
+        timing.start = std::chrono::duration<double, std::milli>(start - m_frameStart).count();
+        timing.duration = std::chrono::duration<double, std::milli>(end - start).count();
+        timing.thread = thread;
+        m_report.systemTime += timing.duration;
+
+        if (error && !m_error)
+        {
+            m_error = error;
+        }
+
+        // dependent systems still run after an error so the frame always finishes
+        for (unsigned int dependent : m_systems[system].dependents)
+        {
+            if (--m_remainingDependencies[dependent] == 0)
+            {
+                makeReady(dependent);
+            }
+        }
+        ++m_finished;
+    }
+
+    m_stateChanged.notify_all();
+}
+
+void Engine::Systems::Scheduler::makeReady(unsigned int system)
+{
+    if (m_systems[system].mainThread)
+    {
+        m_readyMain.push_back(system);
+    }
+    else
+    {
+        m_ready.push_back(system);
+    }
+}
+
+const Engine::Systems::FrameReport &Engine::Systems::Scheduler::getReport() const { return m_report; }
+
+unsigned int Engine::Systems::Scheduler::getNumThreads() const { return m_workers.size() + 1; }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef ENGINE_CORE_SYSTEMS_SCHEDULER
+#define ENGINE_CORE_SYSTEMS_SCHEDULER
+
+#include "../../ECS/commandBuffer.h"
+#include "../../ECS/registry.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+namespace Systems
+{
+// component types a system reads
+template <typename... ComponentTypes>
+struct Reads
+{
+};
+
+// component types a system writes
+template <typename... ComponentTypes>
+struct Writes
+{
+};
+
+struct SystemTiming
+{
+    std::string name;
+    // milliseconds since the start of the frame
+    double start;
+    double duration;
+    // 0 is the thread that called run()
+    unsigned int thread;
+};
+
+struct FrameReport
+{
+    // wall clock time of the whole frame in milliseconds
+    double frameTime{0};
+    // summed up time of all systems in milliseconds
+    double systemTime{0};
+    std::vector<SystemTiming> systems{};
+
+    // average number of systems that ran at the same time
+    double parallelism() const { return frameTime > 0 ? systemTime / frameTime : 0; }
+};
+
+// runs systems once per frame; systems that don't write components another system reads or writes run concurrently on
+// a thread pool while conflicting systems run in the order they were added
+// systems that run concurrently may only read and write the components of existing entities; adding or removing
+// components, entities or callbacks and calling updated() isn't thread safe and should be recorded into the command
+// buffer of the system instead (the buffers are submitted in the order the systems were added once all systems are
+// done)
+class Scheduler
+{
+public:
+    using system_function = std::function<void(Registry &)>;
+    using buffered_system_function = std::function<void(Registry &, CommandBuffer &)>;
+
+    Scheduler() = delete;
+    // numThreads is the number of worker threads besides the one calling run() (hardware concurrency - 1 by default)
+    Scheduler(Registry &registry, int numThreads = -1);
+    Scheduler(const Scheduler &other) = delete;
+    ~Scheduler();
+
+    // main thread systems (e.g. ones issuing OpenGL calls) are only run by the thread that calls run()
+    template <typename... ReadTypes, typename... WriteTypes>
+    void addSystem(const std::string &name,
+                   Reads<ReadTypes...>,
+                   Writes<WriteTypes...>,
+                   system_function run,
+                   bool mainThread = false)
+    {
+        addSystem(
+            name,
+            Reads<ReadTypes...>{},
+            Writes<WriteTypes...>{},
+            [run = std::move(run)](Registry &registry, CommandBuffer &) { run(registry); },
+            mainThread);
+    }
+
+    // systems that want to make structural changes record them into the given command buffer
+    template <typename... ReadTypes, typename... WriteTypes>
+    void addSystem(const std::string &name,
+                   Reads<ReadTypes...>,
+                   Writes<WriteTypes...>,
+                   buffered_system_function run,
+                   bool mainThread = false)
+    {
+        System system{};
+        system.name = name;
+        system.reads = {type_index<ReadTypes>::value()...};
+        system.writes = {type_index<WriteTypes>::value()...};
+        system.declared = {type_index<ReadTypes>::value()..., type_index<WriteTypes>::value()...};
+        system.run = std::move(run);
+        system.mainThread = mainThread;
+        // the tables have to exist before the systems access them concurrently
+        system.prepare = [](Registry &registry) { registry.ensureTables<ReadTypes..., WriteTypes...>(); };
+
+        add(std::move(system));
+    }
+
+    // runs every system once, waits for all of them to finish and submits their command buffers
+    void run();
+
+    const FrameReport &getReport() const;
+
+    unsigned int getNumThreads() const;
+
+private:
+    struct System
+    {
+        std::string name;
+        std::vector<unsigned int> reads;
+        std::vector<unsigned int> writes;
+        // reads and writes (debug builds check that the system only accesses these types)
+        std::vector<unsigned int> declared;
+        buffered_system_function run;
+        bool mainThread;
+        CommandBuffer commands;
+        std::function<void(Registry &)> prepare;
+        // systems that have to wait for this one
+        std::vector<unsigned int> dependents;
+        unsigned int numDependencies;
+    };
+
+    Registry &m_registry;
+    std::vector<System> m_systems{};
+
+    std::vector<std::thread> m_workers{};
+    std::mutex m_mutex{};
+    std::condition_variable m_stateChanged{};
+    bool m_stopping{false};
+
+    // state of the current frame (guarded by m_mutex)
+    std::deque<unsigned int> m_ready{};
+    std::deque<unsigned int> m_readyMain{};
+    std::vector<unsigned int> m_remainingDependencies{};
+    unsigned int m_finished{0};
+    std::exception_ptr m_error{};
+
+    std::chrono::steady_clock::time_point m_frameStart{};
+    FrameReport m_report{};
+
+    void add(System &&system);
+    bool conflict(const System &a, const System &b) const;
+
+    void work(unsigned int thread);
+    void execute(unsigned int system, unsigned int thread);
+    void makeReady(unsigned int system);
+};
+} // namespace Systems
+} // namespace Engine
+
+#endif
\ No newline at end of file
@@ -46,44 +46,31 @@ void calculateBoundingIntersection(Engine::Util::Ray &ray,
                                    std::set<Engine::Util::RayIntersection> &intersections,
                                    unsigned int entity);
 
-void calculateGeometryIntersections(unsigned int entity,
-                                    Engine::Util::Ray &ray,
-                                    Engine::Registry &registry,
-                                    std::set<Engine::Util::RayIntersection> &intersections);
-
 std::set<Engine::Util::RayIntersection> Engine::Util::castRay(Engine::Util::Ray &ray, Registry &registry)
 {
-    // TODO: this will prevent non rendered elements from getting hit
-    // the raycaster should be more general than rendering
-    auto &renderableEntitiesLists = registry.getOwners<Engine::RenderComponent>();
-
     std::set<RayIntersection> intersections{};
 
-    for (auto &entities : renderableEntitiesLists)
-    {
-        for (auto entity : entities)
-        {
-            calculateGeometryIntersections(entity, ray, registry, intersections);
-        }
-    }
+    // TODO: this will prevent non rendered elements from getting hit
+    // the raycaster should be more general than rendering
+    registry.view<Engine::RenderComponent, Engine::GeometryComponent, Engine::TransformComponent>().each(
+        [&](unsigned int entity, RenderComponent &, GeometryComponent &geometry, TransformComponent &transform)
+        { castRay(ray, entity, geometry, transform, intersections); });
 
     return intersections;
 }
 
 // based on: https://www.youtube.com/watch?v=PI5jbAdT2zE
-void calculateGeometryIntersections(unsigned int entity,
-                                    Engine::Util::Ray &ray,
-                                    Engine::Registry &registry,
-                                    std::set<Engine::Util::RayIntersection> &intersections)
+void Engine::Util::castRay(Ray &ray,
+                           unsigned int entity,
+                           GeometryComponent &geometry,
+                           TransformComponent &transform,
+                           std::set<RayIntersection> &intersections)
 {
-    auto geometry = registry.getComponent<Engine::GeometryComponent>(entity);
-    auto transform = registry.getComponent<Engine::TransformComponent>(entity);
-
     // transform the ray into model space for following geometry comparisons
-    Engine::Util::Ray transformedRay = transform->getMatrixWorldInverse() * ray;
+    Engine::Util::Ray transformedRay = transform.getMatrixWorldInverse() * ray;
 
     calculateBoundingIntersection(
-        transformedRay, geometry->getAccStructure(), *geometry, *transform, intersections, entity);
+        transformedRay, geometry.getAccStructure(), geometry, transform, intersections, entity);
 }
 
 void sortMinMax(float &a, float &b)
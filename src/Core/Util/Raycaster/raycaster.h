@@ -7,6 +7,8 @@
 namespace Engine
 {
 class Registry;
+class GeometryComponent;
+class TransformComponent;
 
 namespace Util
 {
@@ -52,6 +54,13 @@ bool operator<(const RayIntersection &a, const RayIntersection &b);
 
 std::set<RayIntersection> castRay(Ray &ray, Registry &registry);
 
+// adds the intersections of the ray with the geometry of a single entity (lets callers pick the geometries themselves)
+void castRay(Ray &ray,
+             unsigned int entity,
+             GeometryComponent &geometry,
+             TransformComponent &transform,
+             std::set<RayIntersection> &intersections);
+
 } // namespace Util
 
 } // namespace Engine
@@ -4,6 +4,11 @@
 #include <cstring>
 #include <glad/glad.h>
 
+Engine::OpenGLMaterialComponent::OpenGLMaterialComponent(const OpenGLMaterialComponent &other)
+    : m_dataInfo{other.m_dataInfo}, m_data{other.m_data}
+{
+}
+
 Engine::OpenGLMaterialComponent::~OpenGLMaterialComponent()
 {
     if (m_UBO != 0)
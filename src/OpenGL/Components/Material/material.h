@@ -17,6 +17,9 @@ class OpenGLMaterialComponent
 {
 public:
     OpenGLMaterialComponent() {}
+    // a copy gets its own uniform buffer (created on the next update)
+    OpenGLMaterialComponent(const OpenGLMaterialComponent &other);
+    OpenGLMaterialComponent &operator=(const OpenGLMaterialComponent &other) = delete;
     ~OpenGLMaterialComponent();
 
     void setMaterialData(const ShaderMaterialData &materialData);
@@ -5,6 +5,11 @@ Engine::OpenGLShaderComponent::OpenGLShaderComponent(std::vector<OpenGLShader> s
     setupUniforms();
 }
 
+Engine::OpenGLShaderComponent::OpenGLShaderComponent(const OpenGLShaderComponent &other) : m_program{other.m_program}
+{
+    setupUniforms();
+}
+
 void Engine::OpenGLShaderComponent::updateShaders(std::vector<OpenGLShader> &newShaders)
 {
     try
@@ -15,6 +15,7 @@ class OpenGLShaderComponent
 public:
     OpenGLShaderComponent() = delete;
     OpenGLShaderComponent(std::vector<OpenGLShader> shaders);
+    OpenGLShaderComponent(const OpenGLShaderComponent &other);
 
     void updateShaders(std::vector<OpenGLShader> &newShaders);
     std::vector<OpenGLShader> getShaders();
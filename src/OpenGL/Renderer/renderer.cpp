@@ -32,19 +32,20 @@ void Engine::OpenGLRenderer::render(const std::vector<unsigned int> &renderables
     glBindBufferBase(GL_UNIFORM_BUFFER, 5, m_pointLightsInfoUBO);
     glBindBufferBase(GL_UNIFORM_BUFFER, 6, m_spotLightsInfoUBO);
 
+    // plain references keep the per draw reference counting out of the loop
     for (auto entity : renderables)
     {
-        auto shader{m_registry.getComponent<Engine::OpenGLShaderComponent>(entity)};
+        auto shader{m_registry.getComponentRef<Engine::OpenGLShaderComponent>(entity)};
         shader->useShader();
         glUniform1i(shader->getLocation("fIndex"), (int)entity);
 
-        m_registry.getComponent<Engine::OpenGLMaterialComponent>(entity)->bind();
+        m_registry.getComponentRef<Engine::OpenGLMaterialComponent>(entity)->bind();
 
-        m_registry.getComponent<Engine::OpenGLTransformComponent>(entity)->bind(1);
+        m_registry.getComponentRef<Engine::OpenGLTransformComponent>(entity)->bind(1);
 
-        auto texture = m_registry.getComponent<Engine::OpenGLTextureComponent>(entity);
+        auto texture = m_registry.getComponentRef<Engine::OpenGLTextureComponent>(entity);
         texture->bind();
-        m_registry.getComponent<Engine::OpenGLGeometryComponent>(entity)->draw();
+        m_registry.getComponentRef<Engine::OpenGLGeometryComponent>(entity)->draw();
         texture->unbind();
     }
 
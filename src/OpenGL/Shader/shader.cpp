@@ -107,6 +107,8 @@ void Engine::OpenGLProgram::cleanupShaders()
     }
 }
 
+Engine::OpenGLProgram::OpenGLProgram(const OpenGLProgram &other) : OpenGLProgram{other.getShaders()} {}
+
 Engine::OpenGLProgram::~OpenGLProgram()
 {
     cleanupShaders();
@@ -310,7 +312,7 @@ std::vector<Engine::OpenGLShader> Engine::loadShaders(const char *directoryPaths
     return shaders;
 }
 
-std::vector<Engine::OpenGLShader> Engine::OpenGLProgram::getShaders()
+std::vector<Engine::OpenGLShader> Engine::OpenGLProgram::getShaders() const
 {
     std::vector<OpenGLShader> shaders{};
 
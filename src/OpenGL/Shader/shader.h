@@ -48,6 +48,9 @@ private:
 
 public:
     OpenGLProgram(std::vector<OpenGLShader> shaders);
+    // a copy compiles and links its own program from the same sources
+    OpenGLProgram(const OpenGLProgram &other);
+    OpenGLProgram &operator=(const OpenGLProgram &other) = delete;
     ~OpenGLProgram();
     void use();
     GLuint getBlockIndex(const char *blockName);
@@ -55,7 +58,7 @@ public:
 
     int getLocation(const char* name);
 
-    std::vector<OpenGLShader> getShaders();
+    std::vector<OpenGLShader> getShaders() const;
 
     void updateProgram(std::vector<OpenGLShader> newShaders);
 };
@@ -22,7 +22,7 @@ Engine::Systems::OpenGLCameraTracker::OpenGLCameraTracker(unsigned int &cameraUB
     glBufferData(GL_UNIFORM_BUFFER, sizeof(baseCameraTransforms), baseCameraTransforms, GL_DYNAMIC_DRAW);
 
     m_changeActive = m_registry.onAdded<ActiveCameraComponent>(
-        [this](unsigned int entity, std::weak_ptr<ActiveCameraComponent> active)
+        [this](unsigned int entity, ActiveCameraComponent *active)
         {
             if (auto camera{this->m_registry.getComponent<CameraComponent>(entity)})
             {
@@ -50,7 +50,7 @@ Engine::Systems::OpenGLCameraTracker::OpenGLCameraTracker(unsigned int &cameraUB
     createInitActiveCB();
 
     m_removeActive = m_registry.onRemove<ActiveCameraComponent>(
-        [this](unsigned int entity, std::weak_ptr<ActiveCameraComponent> active)
+        [this](unsigned int entity, ActiveCameraComponent *active)
         {
             if (this->m_currentActiveCamera == entity)
             {
@@ -112,29 +112,16 @@ void Engine::Systems::OpenGLCameraTracker::createUpdateActiveCB()
 
 void Engine::Systems::OpenGLCameraTracker::makeActiveUnique()
 {
-    std::vector<std::shared_ptr<ActiveCameraComponent>> activeCameras{
-        m_registry.getComponents<ActiveCameraComponent>()};
+    // copy since removing the tags changes the list
+    std::vector<unsigned int> activeCameras{m_registry.getEntities<ActiveCameraComponent>()};
 
-    std::vector<std::shared_ptr<ActiveCameraComponent>>::const_reverse_iterator it = activeCameras.rbegin();
-    std::vector<std::shared_ptr<ActiveCameraComponent>>::const_reverse_iterator endIt = activeCameras.rend();
     // remove all ActiveCameraComponents that are not the current one
-    while (it != activeCameras.rend())
+    for (unsigned int entity : activeCameras)
     {
-        std::list<unsigned int> owners{m_registry.getOwners<ActiveCameraComponent>(*it)};
-
-        std::list<unsigned int>::const_reverse_iterator ownerIt = owners.rbegin();
-
-        while (ownerIt != owners.rend())
+        if (entity != m_currentActiveCamera)
         {
-            if (*ownerIt != m_currentActiveCamera)
-            {
-                m_registry.removeComponent<ActiveCameraComponent>(*ownerIt);
-            }
-
-            ++ownerIt;
+            m_registry.removeComponent<ActiveCameraComponent>(entity);
         }
-
-        ++it;
     }
 }
 
@@ -2,6 +2,7 @@
 #define ENGINE_OPENGL_SYSTEMS_CAMERATRACKER
 
 #include "../../../Core/Math/math.h"
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <glad/glad.h>
 #include <memory>
@@ -21,17 +22,15 @@ private:
 
     // cb that makes a new camera active if there is no currently active camera or updates the buffer if the currently
     // active camera changes
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<CameraComponent> camera)>> m_activeCB{};
+    Connection m_activeCB{};
     // cb that makes sure that only one camera is currently active
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ActiveCameraComponent> activeCamera)>>
-        m_changeActive;
+    Connection m_changeActive;
     // cb that handles when the active camera is set to being inactive
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<ActiveCameraComponent> activeCamera)>>
-        m_removeActive;
+    Connection m_removeActive;
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>> m_addTransformCB;
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>> m_updateTransformCB;
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>> m_removeTransformCB;
+    Connection m_addTransformCB;
+    Connection m_updateTransformCB;
+    Connection m_removeTransformCB;
 
     int m_currentActiveCamera{-1};
 
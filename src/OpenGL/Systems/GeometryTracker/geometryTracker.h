@@ -1,6 +1,7 @@
 #ifndef ENGINE_OPENGL_SYSTEM_GEOMETRYTRACKER
 #define ENGINE_OPENGL_SYSTEM_GEOMETRYTRACKER
 
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <memory>
 
@@ -23,14 +24,11 @@ public:
 private:
     Registry &m_registry;
 
-    using geometry_callback =
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::GeometryComponent>)>>;
+    Connection m_updateCallback;
 
-    geometry_callback m_updateCallback;
+    Connection m_removeCallback;
 
-    geometry_callback m_removeCallback;
-
-    geometry_callback m_swapCallback;
+    Connection m_swapCallback;
 
     void update(unsigned int entity, GeometryComponent *geometry);
     void remove(unsigned int entity, GeometryComponent *geometry);
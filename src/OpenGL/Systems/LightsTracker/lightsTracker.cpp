@@ -22,11 +22,7 @@ Engine::Systems::OpenGLLightsTracker<LightType>::OpenGLLightsTracker(unsigned in
             {
                 m_entityData.emplace(
                     entity,
-                    meta_data{0,
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<LightType>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<LightType>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>{},
-                              std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>{}});
+                    meta_data{0, Connection{}, Connection{}, Connection{}, Connection{}});
 
                 addLight(entity, light.lock());
                 resetTransformInfo(entity);
@@ -1,6 +1,7 @@
 #ifndef ENGINE_OPENGL_SYSTEM_LIGHTSTRACKER
 #define ENGINE_OPENGL_SYSTEM_LIGHTSTRACKER
 
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <glad/glad.h>
 #include <map>
@@ -27,21 +28,14 @@ private:
     Registry &m_registry;
 
     // cb that sets up tracking of lights that get added
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<LightType> light)>> m_AddLightCB{};
+    Connection m_AddLightCB{};
 
-    using meta_data = std::tuple<
-        size_t, // the offset at which the information for this entities light starts
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<LightType>)>>, // callback for when the entity
-                                                                                      // has a light added or updated
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<LightType>)>>, // callback for when the entity
-                                                                                      // has its light removed
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>, // callback for when the
-                                                                                               // entity has a transform
-                                                                                               // added or updated
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<TransformComponent>)>>  // callback for when the
-                                                                                               // entity has its
-                                                                                               // transform removed
-        >;
+    using meta_data = std::tuple<size_t,     // the offset at which the information for this entities light starts
+                                 Connection, // callback for when the entity has a light added or updated
+                                 Connection, // callback for when the entity has its light removed
+                                 Connection, // callback for when the entity has a transform added or updated
+                                 Connection  // callback for when the entity has its transform removed
+                                 >;
 
     std::map<unsigned int, meta_data> m_entityData{};
 
@@ -1,6 +1,7 @@
 #ifndef ENGINE_OPENGL_SYSTEM_MATERIALTRACKER
 #define ENGINE_OPENGL_SYSTEM_MATERIALTRACKER
 
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <memory>
 
@@ -23,12 +24,9 @@ public:
 private:
     Registry &m_registry;
 
-    using geometry_callback =
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::OpenGLMaterialComponent>)>>;
+    Connection m_addCallback;
 
-    geometry_callback m_addCallback;
-
-    geometry_callback m_swapCallback;
+    Connection m_swapCallback;
 
     void update(unsigned int entity, OpenGLMaterialComponent *geometry);
 };
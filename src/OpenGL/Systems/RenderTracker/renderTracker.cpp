@@ -11,19 +11,36 @@
 #include "../../Components/Shader/shader.h"
 #include "../../Components/Texture/texture.h"
 
-#include <algorithm>
-
 Engine::Systems::OpenGLRenderTracker::OpenGLRenderTracker(Registry &registry, std::vector<unsigned int> &renderables)
-    : m_registry{registry}, m_renderables{renderables}
+    : m_registry{registry}, m_renderables{renderables}, m_renderObserver{registry.observe<RenderComponent>()}
 {
-    m_addCallback = m_registry.onAdded<RenderComponent>(
-        [this](unsigned int entity, std::weak_ptr<RenderComponent> render) { this->makeRenderable(entity); });
+}
 
-    m_removeCallback = m_registry.onRemove<RenderComponent>(
-        [this](unsigned int entity, std::weak_ptr<RenderComponent> render) {
-            m_renderables.erase(std::remove(m_renderables.begin(), m_renderables.end(), entity), m_renderables.end());
-        }
-    );
+Engine::Systems::OpenGLRenderTracker::~OpenGLRenderTracker() {}
+
+void Engine::Systems::OpenGLRenderTracker::update()
+{
+    // making an entity renderable might make its children renderable as well
+    while (!m_renderObserver->empty())
+    {
+        m_renderObserver->drain([this](unsigned int entity) { this->removeRenderable(entity); },
+                                [this](unsigned int entity) { this->makeRenderable(entity); });
+    }
+}
+
+void Engine::Systems::OpenGLRenderTracker::removeRenderable(unsigned int entity)
+{
+    int position = m_renderablePositions.get(entity);
+    if (position == -1)
+    {
+        return;
+    }
+
+    unsigned int lastEntity = m_renderables.back();
+    m_renderables[position] = lastEntity;
+    m_renderablePositions.set(lastEntity, position);
+    m_renderables.pop_back();
+    m_renderablePositions.set(entity, -1);
 }
 
 void Engine::Systems::OpenGLRenderTracker::makeRenderable(unsigned int entity)
@@ -37,6 +54,7 @@ void Engine::Systems::OpenGLRenderTracker::makeRenderable(unsigned int entity)
     // TODO: texture not always necessary
     ensureTexture(entity);
 
+    m_renderablePositions.set(entity, m_renderables.size());
     m_renderables.push_back(entity);
 
     // render children
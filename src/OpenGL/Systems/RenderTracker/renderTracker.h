@@ -1,15 +1,17 @@
 #ifndef ENGINE_OPENGL_SYSTEM_RENDERTRACKER
 #define ENGINE_OPENGL_SYSTEM_RENDERTRACKER
 
-#include <functional>
-#include <list>
-#include <map>
+#include "../../../Core/ECS/sparseArray.h"
+#include "../../../Core/ECS/util.h"
 #include <memory>
+#include <vector>
 
 namespace Engine
 {
 class Registry;
 class RenderComponent;
+template <typename Config, typename... ComponentTypes>
+class BasicObserver;
 
 namespace Systems
 {
@@ -20,19 +22,23 @@ public:
     OpenGLRenderTracker() = delete;
 
     OpenGLRenderTracker(Registry &registry, std::vector<unsigned int> &renderables);
+    ~OpenGLRenderTracker();
+
+    // brings the renderables up to date with the render components added and removed since the last call (has to be
+    // called before rendering)
+    void update();
 
 private:
     Registry &m_registry;
     std::vector<unsigned int> &m_renderables;
+    // position of each entity inside m_renderables
+    PagedSparseArray<int> m_renderablePositions{-1};
 
-    // callback type for component events (add, update, remove)
-    using render_callback = std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::RenderComponent>)>>;
-
-    // callback that tracks addition of new render components
-    render_callback m_addCallback;
-    render_callback m_removeCallback;
+    // collects the entities that got or lost a render component
+    std::unique_ptr<BasicObserver<entity_config32, RenderComponent>> m_renderObserver;
 
     void makeRenderable(unsigned int entityId);
+    void removeRenderable(unsigned int entityId);
 
     void ensureGeometry(unsigned int entity);
 
@@ -1,6 +1,7 @@
 #ifndef ENGINE_OPENGL_SYSTEM_SHADERTRACKER
 #define ENGINE_OPENGL_SYSTEM_SHADERTRACKER
 
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <memory>
 
@@ -23,12 +24,9 @@ public:
 private:
     Registry &m_registry;
 
-    using shader_callback =
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::OpenGLShaderComponent>)>>;
-
-    shader_callback m_addCallback;
-    shader_callback m_updateCallback;
-    shader_callback m_swapCallback;
+    Connection m_addCallback;
+    Connection m_updateCallback;
+    Connection m_swapCallback;
 
     void update(unsigned int entity, OpenGLShaderComponent *shader);
 };
@@ -1,6 +1,7 @@
 #ifndef ENGINE_OPENGL_SYSTEM_TRANSFORMTRACKER
 #define ENGINE_OPENGL_SYSTEM_TRANSFORMTRACKER
 
+#include "../../../Core/ECS/signal.h"
 #include <functional>
 #include <memory>
 
@@ -23,14 +24,11 @@ public:
 private:
     Registry &m_registry;
 
-    using transform_callback =
-        std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<Engine::TransformComponent>)>>;
+    Connection m_updateCallback;
 
-    transform_callback m_updateCallback;
+    Connection m_removeCallback;
 
-    transform_callback m_removeCallback;
-
-    transform_callback m_swapCallback;
+    Connection m_swapCallback;
 
     void update(unsigned int entity, TransformComponent *geometry);
     void remove(unsigned int entity);
@@ -3,6 +3,7 @@
 #include "../Core/Components/Camera/camera.h"
 #include "../Core/Components/Geometry/geometry.h"
 #include "../Core/Components/Light/light.h"
+#include "../Core/Components/Render/render.h"
 #include "../Core/Components/Transform/transform.h"
 #include "../Core/ECS/registry.h"
 #include "../Core/Util/Raycaster/raycaster.h"
@@ -10,13 +11,30 @@
 
 #include <thread>
 
-Engine::Vector4 calculateColor(Engine::Registry &registry, Engine::Util::Ray &ray);
+// the worker threads only read from a frozen copy of the tables so the registry can't change underneath them
+using RaytracingScene = Engine::FrozenRegistry<Engine::ActiveCameraComponent,
+                                               Engine::CameraComponent,
+                                               Engine::TransformComponent,
+                                               Engine::GeometryComponent,
+                                               Engine::RenderComponent,
+                                               Engine::RaytracingMaterial,
+                                               Engine::PointLightComponent>;
+
+Engine::Vector4 calculateColor(const RaytracingScene &scene, Engine::Util::Ray &ray);
 
 void raytraceScenePart(
-    Engine::Registry &registry, std::vector<float> &texels, int start, int numTexels, int width, int height);
+    const RaytracingScene &scene, std::vector<float> &texels, int start, int numTexels, int width, int height);
 
 std::vector<float> Engine::raytraceScene(Engine::Registry &registry, int width, int height)
 {
+    const RaytracingScene scene{registry.freeze<Engine::ActiveCameraComponent,
+                                                Engine::CameraComponent,
+                                                Engine::TransformComponent,
+                                                Engine::GeometryComponent,
+                                                Engine::RenderComponent,
+                                                Engine::RaytracingMaterial,
+                                                Engine::PointLightComponent>()};
+
     std::vector<float> pixelColors{};
     pixelColors.resize(3 * width * height, 0);
 
@@ -32,7 +50,7 @@ std::vector<float> Engine::raytraceScene(Engine::Registry &registry, int width,
     for (int i{0}; i < possibleThreads - 1; ++i)
     {
         threads.emplace_back(std::thread(raytraceScenePart,
-                                         std::ref(registry),
+                                         std::cref(scene),
                                          std::ref(pixelColors),
                                          currentOffset,
                                          texelsPerThread,
@@ -42,7 +60,7 @@ std::vector<float> Engine::raytraceScene(Engine::Registry &registry, int width,
     }
 
     threads.emplace_back(std::thread(raytraceScenePart,
-                                     std::ref(registry),
+                                     std::cref(scene),
                                      std::ref(pixelColors),
                                      currentOffset,
                                      (width * height) - currentOffset,
@@ -58,10 +76,10 @@ std::vector<float> Engine::raytraceScene(Engine::Registry &registry, int width,
 }
 
 void raytraceScenePart(
-    Engine::Registry &registry, std::vector<float> &texels, int start, int numTexels, int width, int height)
+    const RaytracingScene &scene, std::vector<float> &texels, int start, int numTexels, int width, int height)
 {
-    unsigned int activeCameraEntity = registry.getOwners<Engine::ActiveCameraComponent>()[0].front();
-    auto camera = registry.getComponent<Engine::CameraComponent>(activeCameraEntity);
+    unsigned int activeCameraEntity = scene.getEntities<Engine::ActiveCameraComponent>().front();
+    auto camera = scene.getComponent<Engine::CameraComponent>(activeCameraEntity);
     Engine::CameraComponent adjustedCamera{*camera};
     adjustedCamera.setAspect((float)width / (float)height);
 
@@ -74,7 +92,7 @@ void raytraceScenePart(
 
         Engine::Util::Ray cameraRay = adjustedCamera.getCameraRay({x, y}, {width, height});
 
-        color = calculateColor(registry, cameraRay);
+        color = calculateColor(scene, cameraRay);
 
         texels[3 * i] = color(0);
         texels[3 * i + 1] = color(1);
@@ -82,13 +100,27 @@ void raytraceScenePart(
     }
 }
 
-Engine::Vector4 calculateLighting(Engine::Registry &registry,
+Engine::Vector4 calculateLighting(const RaytracingScene &scene,
                                   const Engine::Vector4 &materialColor,
                                   const Engine::Util::RayIntersection &intersection);
 
-Engine::Vector4 calculateColor(Engine::Registry &registry, Engine::Util::Ray &ray)
+std::set<Engine::Util::RayIntersection> castRay(const RaytracingScene &scene, Engine::Util::Ray &ray)
+{
+    std::set<Engine::Util::RayIntersection> intersections{};
+
+    scene.each<Engine::RenderComponent, Engine::GeometryComponent, Engine::TransformComponent>(
+        [&](unsigned int entity,
+            Engine::RenderComponent &,
+            Engine::GeometryComponent &geometry,
+            Engine::TransformComponent &transform)
+        { Engine::Util::castRay(ray, entity, geometry, transform, intersections); });
+
+    return intersections;
+}
+
+Engine::Vector4 calculateColor(const RaytracingScene &scene, Engine::Util::Ray &ray)
 {
-    auto intersections = Engine::Util::castRay(ray, registry);
+    auto intersections = castRay(scene, ray);
 
     if (!intersections.size())
     {
@@ -99,14 +131,14 @@ Engine::Vector4 calculateColor(Engine::Registry &registry, Engine::Util::Ray &ra
 
     unsigned int entity = intersection.getEntity();
 
-    if (auto material = registry.getComponent<Engine::RaytracingMaterial>(entity))
+    if (auto material = scene.getComponent<Engine::RaytracingMaterial>(entity))
     {
         if (material->isReflective())
         {
             auto intersection = *intersections.begin();
             auto intersectionEntity = intersection.getEntity();
-            auto geometry = registry.getComponent<Engine::GeometryComponent>(intersectionEntity);
-            auto transform = registry.getComponent<Engine::TransformComponent>(intersectionEntity);
+            auto geometry = scene.getComponent<Engine::GeometryComponent>(intersectionEntity);
+            auto transform = scene.getComponent<Engine::TransformComponent>(intersectionEntity);
 
             auto baryParams = intersection.getBaryParams();
 
@@ -127,35 +159,32 @@ Engine::Vector4 calculateColor(Engine::Registry &registry, Engine::Util::Ray &ra
             auto newOrigin =
                 intersection.getIntersection() + reflectedDirection * 10 * std::numeric_limits<float>::epsilon();
             Engine::Util::Ray reflectedRay{newOrigin, reflectedDirection};
-            return calculateColor(registry, reflectedRay);
+            return calculateColor(scene, reflectedRay);
         }
         else
         {
-            return calculateLighting(registry, material->getColor(), intersection);
+            return calculateLighting(scene, material->getColor(), intersection);
         }
     }
 
     return Engine::Vector4{0.9, 0.126, 0.777, 1};
 }
 
-Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
+Engine::Vector4 calculatePointLightColor(const RaytracingScene &scene,
                                          unsigned int entity,
+                                         Engine::PointLightComponent &light,
                                          const Engine::Util::RayIntersection &intersection,
                                          const Engine::Vector4 &materialColor);
 
-Engine::Vector4 calculateLighting(Engine::Registry &registry,
+Engine::Vector4 calculateLighting(const RaytracingScene &scene,
                                   const Engine::Vector4 &materialColor,
                                   const Engine::Util::RayIntersection &intersection)
 {
     Engine::Vector4 color{0, 0, 0, 0};
 
-    for (auto &pointLightOwners : registry.getOwners<Engine::PointLightComponent>())
-    {
-        for (auto owner : pointLightOwners)
-        {
-            color += calculatePointLightColor(registry, owner, intersection, materialColor);
-        }
-    }
+    scene.each<Engine::PointLightComponent>(
+        [&](unsigned int entity, Engine::PointLightComponent &light)
+        { color += calculatePointLightColor(scene, entity, light, intersection, materialColor); });
 
     return color;
 }
@@ -175,14 +204,15 @@ float clamp(float val, float min, float max)
     return val;
 }
 
-Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
+Engine::Vector4 calculatePointLightColor(const RaytracingScene &scene,
                                          unsigned int entity,
+                                         Engine::PointLightComponent &light,
                                          const Engine::Util::RayIntersection &intersection,
                                          const Engine::Vector4 &materialColor)
 {
     Engine::Point3 lighPosition{0, 0, 0};
 
-    if (auto lightTransform = registry.getComponent<Engine::TransformComponent>(entity))
+    if (auto lightTransform = scene.getComponent<Engine::TransformComponent>(entity))
     {
         lighPosition = lightTransform->getMatrixWorld() * lighPosition;
     }
@@ -190,8 +220,8 @@ Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
     unsigned int intersectionEntity = intersection.getEntity();
     int intersectionFaceIndex = intersection.getFace();
 
-    auto geometry = registry.getComponent<Engine::GeometryComponent>(intersectionEntity);
-    auto transform = registry.getComponent<Engine::TransformComponent>(intersectionEntity);
+    auto geometry = scene.getComponent<Engine::GeometryComponent>(intersectionEntity);
+    auto transform = scene.getComponent<Engine::TransformComponent>(intersectionEntity);
 
     auto baryParams = intersection.getBaryParams();
 
@@ -216,7 +246,7 @@ Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
 
     auto lightRay = Engine::Util::Ray(origin, lightVector);
 
-    auto shadowIntersections = Engine::Util::castRay(lightRay, registry);
+    auto shadowIntersections = castRay(scene, lightRay);
 
     // if there was an intersection between the object and the light then it is in shadow
     if (shadowIntersections.size() && shadowIntersections.begin()->getDistance() < lightDist)
@@ -226,12 +256,10 @@ Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
 
     float lightAngle = clamp(dot(lightVector, surfaceNormal), 0, 1);
 
-    auto light = registry.getComponent<Engine::PointLightComponent>(entity);
-
     auto reflected{normalize(reflect(-lightVector, surfaceNormal))};
 
-    auto activeCamera{registry.getOwners<Engine::ActiveCameraComponent>()[0].front()};
-    auto cameraTransform{registry.getComponent<Engine::TransformComponent>(activeCamera)};
+    auto activeCamera{scene.getEntities<Engine::ActiveCameraComponent>().front()};
+    auto cameraTransform{scene.getComponent<Engine::TransformComponent>(activeCamera)};
     auto cameraPosition{cameraTransform->getViewMatrixInverse() * Engine::Point3{0, 0, 0}};
     auto cameraDirection{normalize((cameraPosition - intersection.getIntersection()))};
 
@@ -239,5 +267,5 @@ Engine::Vector4 calculatePointLightColor(Engine::Registry &registry,
 
     s = std::max<float>(pow(s, 100), 0.0f);
 
-    return lightAngle * Engine::Vector4{light->getColor(), 1} * materialColor + s * Engine::Vector4{1, 1, 1, 1};
+    return lightAngle * Engine::Vector4{light.getColor(), 1} * materialColor + s * Engine::Vector4{1, 1, 1, 1};
 }
\ No newline at end of file
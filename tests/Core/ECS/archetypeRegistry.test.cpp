@@ -0,0 +1,200 @@
+#include <Core/ECS/archetypeRegistry.h>
+#include <Core/ECS/registry.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+TEST(ECS_ARCHETYPE_REGISTRY_TEST, components)
+{
+    Engine::ArchetypeRegistry registry{};
+
+    unsigned int entity = registry.addEntity();
+    unsigned int other = registry.addEntity();
+
+    registry.createComponent<int>(entity, 1);
+    registry.createComponent<std::string>(entity, "entity");
+    registry.createComponent<std::string>(other, "other");
+    registry.createComponent<int>(other, 2);
+
+    // both entities end up in the same archetype no matter the order the components were added in
+    EXPECT_EQ(registry.getNumArchetypes(), 4u);
+    EXPECT_EQ(*registry.getComponent<int>(entity), 1);
+    EXPECT_EQ(*registry.getComponent<std::string>(entity), "entity");
+    EXPECT_EQ(*registry.getComponent<int>(other), 2);
+    EXPECT_EQ(*registry.getComponent<std::string>(other), "other");
+
+    // moving the entity into another archetype keeps the components of the entities left behind intact
+    registry.removeComponent<int>(entity);
+    EXPECT_FALSE(registry.hasComponent<int>(entity));
+    EXPECT_EQ(registry.getComponent<int>(entity), nullptr);
+    EXPECT_EQ(*registry.getComponent<std::string>(entity), "entity");
+    EXPECT_EQ(*registry.getComponent<int>(other), 2);
+    EXPECT_EQ(registry.getNumArchetypes(), 4u);
+
+    registry.removeEntity(entity);
+    EXPECT_FALSE(registry.isAlive(entity));
+    EXPECT_EQ(registry.getNumEntities(), 1u);
+    EXPECT_THROW(registry.getComponent<int>(entity), const char *);
+    EXPECT_EQ(*registry.getComponent<std::string>(other), "other");
+}
+
+TEST(ECS_ARCHETYPE_REGISTRY_TEST, each)
+{
+    Engine::ArchetypeRegistry registry{};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        unsigned int entity = registry.addEntity();
+        registry.createComponent<int>(entity, i);
+        if (i % 2 == 0)
+        {
+            registry.createComponent<float>(entity, 0.5f);
+        }
+        if (i % 3 == 0)
+        {
+            registry.createComponent<std::string>(entity, "");
+        }
+    }
+
+    int sum{0};
+    registry.view<int, float>().each(
+        [&](unsigned int entity, int &i, float &f)
+        {
+            EXPECT_EQ(static_cast<int>(entity), i);
+            sum += i;
+            f += 1.0f;
+        });
+    EXPECT_EQ(sum, 0 + 2 + 4 + 6 + 8);
+
+    unsigned int count{0};
+    registry.each<float>([&](float &f) { count += f == 1.5f; });
+    EXPECT_EQ(count, 5u);
+}
+
+TEST(ECS_ARCHETYPE_REGISTRY_TEST, callbacks)
+{
+    Engine::ArchetypeRegistry registry{};
+
+    std::vector<int> added{};
+    std::vector<int> removed{};
+    std::vector<int> updated{};
+    std::vector<int> swapped{};
+    using handle = Engine::ArchetypeHandle<int>;
+    Engine::Connection onAdded = registry.onAdded<int>([&](unsigned int, handle i) { added.push_back(*i); });
+    Engine::Connection onRemove = registry.onRemove<int>([&](unsigned int, handle i) { removed.push_back(*i); });
+    Engine::Connection onUpdate = registry.onUpdate<int>([&](unsigned int, handle i) { updated.push_back(*i); });
+    Engine::Connection onSwap = registry.onComponentSwap<int>([&](unsigned int, handle i) { swapped.push_back(*i); });
+
+    unsigned int entity = registry.addEntity();
+    registry.createComponent<int>(entity, 1);
+    registry.createComponent<int>(entity, 2);
+    *registry.getComponent<int>(entity) = 3;
+    registry.updated<int>(entity);
+    registry.removeEntity(entity);
+
+    EXPECT_EQ(added, std::vector<int>{1});
+    EXPECT_EQ(swapped, std::vector<int>{2});
+    EXPECT_EQ(updated, std::vector<int>{3});
+    EXPECT_EQ(removed, std::vector<int>{3});
+}
+
+TEST(ECS_ARCHETYPE_REGISTRY_TEST, handles)
+{
+    Engine::ArchetypeRegistry registry{};
+
+    unsigned int entity = registry.addEntity();
+    Engine::ArchetypeHandle<int> handle = registry.createComponent<int>(entity, 1);
+
+    // the handle follows the component into other archetypes
+    registry.createComponent<float>(entity, 2.0f);
+    EXPECT_EQ(*handle, 1);
+    EXPECT_EQ(handle, registry.getComponent<int>(entity));
+
+    registry.removeComponent<int>(entity);
+    EXPECT_TRUE(handle.expired());
+
+    // a reused entity id doesn't revive handles to the components of the removed entity
+    registry.createComponent<int>(entity, 3);
+    handle = registry.getComponent<int>(entity);
+    registry.removeEntity(entity);
+    EXPECT_EQ(registry.addEntity(), entity);
+    registry.createComponent<int>(entity, 4);
+    EXPECT_EQ(handle.lock(), nullptr);
+}
+
+TEST(ECS_ARCHETYPE_REGISTRY_TEST, parenthesized_construction)
+{
+    Engine::ArchetypeRegistry registry{};
+
+    unsigned int entity = registry.addEntity();
+    EXPECT_EQ(registry.createComponent<std::vector<int>>(entity, 3u, 7)->size(), 3u);
+    EXPECT_EQ(registry.createComponent<std::vector<int>>(entity, 2u, 7)->size(), 2u);
+}
+
+// code written against the subset of the interface both backends share compiles and behaves the same with either
+template <typename RegistryType>
+class ECS_INTERCHANGEABLE_REGISTRY_TEST : public ::testing::Test
+{
+};
+
+using RegistryTypes = ::testing::Types<Engine::Registry, Engine::ArchetypeRegistry>;
+TYPED_TEST_SUITE(ECS_INTERCHANGEABLE_REGISTRY_TEST, RegistryTypes);
+
+TYPED_TEST(ECS_INTERCHANGEABLE_REGISTRY_TEST, shared_subset)
+{
+    TypeParam registry{};
+
+    std::vector<int> added{};
+    std::vector<int> removed{};
+    std::vector<int> updated{};
+    std::vector<int> swapped{};
+    auto onAdded = registry.template onAdded<int>([&](unsigned int, auto i) { added.push_back(*i.lock()); });
+    auto onRemove = registry.template onRemove<int>([&](unsigned int, auto i) { removed.push_back(*i.lock()); });
+    auto onUpdate = registry.template onUpdate<int>([&](unsigned int, auto i) { updated.push_back(*i.lock()); });
+    auto onSwap = registry.template onComponentSwap<int>([&](unsigned int, auto i) { swapped.push_back(*i.lock()); });
+
+    unsigned int entity = registry.addEntity();
+    unsigned int other = registry.addEntity();
+    registry.template createComponent<int>(entity, 1);
+    registry.template createComponent<std::string>(entity, 3u, 'a');
+    registry.template createComponent<int>(other, 2);
+
+    EXPECT_TRUE(registry.template hasComponent<std::string>(entity));
+    EXPECT_FALSE(registry.template hasComponent<std::string>(other));
+    EXPECT_EQ(*registry.template getComponent<std::string>(entity), "aaa");
+    EXPECT_EQ(registry.template getComponent<std::string>(entity)->size(), 3u);
+    EXPECT_EQ(registry.template getComponent<std::string>(other), nullptr);
+
+    *registry.template getComponent<int>(other) = 5;
+    registry.template updated<int>(other);
+    registry.template createComponent<int>(entity, 6);
+
+    int sum{0};
+    registry.template each<int>([&](int &i) { sum += i; });
+    EXPECT_EQ(sum, 11);
+
+    unsigned int visited{0};
+    registry.template view<int, std::string>().each(
+        [&](unsigned int e, int &i, std::string &s)
+        {
+            EXPECT_EQ(e, entity);
+            EXPECT_EQ(i, 6);
+            EXPECT_EQ(s, "aaa");
+            ++visited;
+        });
+    EXPECT_EQ(visited, 1u);
+
+    registry.template removeComponent<int>(other);
+    registry.removeEntity(entity);
+    EXPECT_FALSE(registry.isAlive(entity));
+    EXPECT_TRUE(registry.isAlive(other));
+
+    EXPECT_EQ(added, (std::vector<int>{1, 2}));
+    EXPECT_EQ(updated, std::vector<int>{5});
+    EXPECT_EQ(swapped, std::vector<int>{6});
+    EXPECT_EQ(removed, (std::vector<int>{5, 6}));
+
+    registry.clear();
+    EXPECT_FALSE(registry.isAlive(other));
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <Core/ECS/commandBuffer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ECS_COMMAND_BUFFER_TEST, submit)
+{
+    Engine::Registry registry{};
+    unsigned int existing = registry.addEntity();
+    registry.createComponent<int>(existing, 1);
+
+    Engine::CommandBuffer buffer{};
+    Engine::PendingEntity pending = buffer.addEntity();
+    buffer.createComponent<std::string>(pending, "name");
+    buffer.createComponent<int>(pending, 2);
+    buffer.removeComponent<int>(existing);
+
+    // nothing happens before the buffer is submitted
+    EXPECT_EQ(buffer.size(), 4u);
+    EXPECT_EQ(registry.getEntities().size(), 1u);
+    EXPECT_TRUE(registry.hasComponent<int>(existing));
+
+    std::vector<unsigned int> updated{};
+    Engine::Connection connection =
+        registry.onUpdate<int>([&](unsigned int entity, std::weak_ptr<int>) { updated.push_back(entity); });
+    buffer.updated<int>(pending);
+
+    std::vector<unsigned int> created = buffer.submit(registry);
+
+    ASSERT_EQ(created.size(), 1u);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(*registry.getComponent<std::string>(created[0]), "name");
+    EXPECT_EQ(*registry.getComponent<int>(created[0]), 2);
+    EXPECT_FALSE(registry.hasComponent<int>(existing));
+    EXPECT_EQ(updated, std::vector<unsigned int>{created[0]});
+
+    // pending entities are local to a submit
+    buffer.removeEntity(created[0]);
+    EXPECT_TRUE(buffer.submit(registry).empty());
+    EXPECT_FALSE(registry.isAlive(created[0]));
+}
+
+TEST(ECS_COMMAND_BUFFER_TEST, shareComponent)
+{
+    Engine::Registry registry{};
+    unsigned int source = registry.addEntity();
+    registry.createComponent<int>(source, 1);
+
+    Engine::CommandBuffer buffer{};
+    Engine::PendingEntity pending = buffer.addEntity();
+    buffer.shareComponent<int>(source, pending);
+    std::vector<unsigned int> created = buffer.submit(registry);
+    EXPECT_EQ(registry.getComponent<int>(created[0]), registry.getComponent<int>(source));
+
+    // the component of the source is looked up on submit; a removed component isn't shared
+    unsigned int target = registry.addEntity();
+    buffer.shareComponent<int>(source, target);
+    registry.removeComponent<int>(source);
+    buffer.submit(registry);
+    EXPECT_FALSE(registry.hasComponent<int>(target));
+    EXPECT_EQ(registry.getComponent<int>(target), nullptr);
+}
+
+TEST(ECS_COMMAND_BUFFER_TEST, buffer_per_thread)
+{
+    Engine::Registry registry{};
+
+    std::vector<Engine::CommandBuffer> buffers(4);
+    std::vector<std::thread> threads{};
+    for (unsigned int i = 0; i < buffers.size(); ++i)
+    {
+        threads.emplace_back(
+            [&buffers, i]()
+            {
+                for (int j = 0; j < 100; ++j)
+                {
+                    buffers[i].createComponent<int>(buffers[i].addEntity(), static_cast<int>(i));
+                }
+            });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // the buffers are submitted on the thread owning the registry
+    for (unsigned int i = 0; i < buffers.size(); ++i)
+    {
+        for (unsigned int entity : buffers[i].submit(registry))
+        {
+            EXPECT_EQ(*registry.getComponent<int>(entity), static_cast<int>(i));
+        }
+    }
+    EXPECT_EQ(registry.getEntities().size(), 400u);
+}
\ No newline at end of file
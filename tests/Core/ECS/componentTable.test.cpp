@@ -108,6 +108,62 @@ TEST(ECS_COMPONENT_TABLE_TEST, getOwners_for_component)
     EXPECT_EQ(ownersB.back(), 1);
 }
 
+TEST(ECS_COMPONENT_TABLE_TEST, removeComponent_keeps_owners)
+{
+    Engine::ComponentTable<int> a{5};
+
+    std::shared_ptr<int> componentA = a.addComponent(0, std::make_shared<int>(1));
+    std::shared_ptr<int> componentB = a.addComponent(1, std::make_shared<int>(2));
+    std::shared_ptr<int> componentC = a.addComponent(2, std::make_shared<int>(3));
+    a.addComponent(3, componentC);
+
+    // the shared last component is moved into the freed index
+    a.removeComponent(0);
+
+    EXPECT_EQ(a.getComponents().size(), 2);
+    EXPECT_EQ(a.getComponent(1), componentB);
+    EXPECT_EQ(a.getComponent(2), componentC);
+    EXPECT_EQ(a.getComponent(3), componentC);
+    EXPECT_EQ(a.getOwners(componentC).size(), 2);
+    EXPECT_EQ(a.getOwners(3).size(), 2);
+    EXPECT_ANY_THROW(a.getOwners(componentA));
+
+    // swapping in a component that gets moved by the removal of the old one
+    std::shared_ptr<int> componentD = a.createComponent(4, 4);
+    a.addComponent(1, componentD);
+
+    EXPECT_EQ(a.getComponents().size(), 2);
+    EXPECT_EQ(a.getComponent(1), componentD);
+    EXPECT_EQ(a.getComponent(4), componentD);
+    EXPECT_EQ(a.getComponent(2), componentC);
+    EXPECT_EQ(a.getOwners(componentD).size(), 2);
+}
+
+TEST(ECS_COMPONENT_TABLE_TEST, removeComponent_unlinks_owners)
+{
+    Engine::ComponentTable<int> a{};
+
+    std::shared_ptr<int> shared = a.createComponent(0, 1);
+    for (unsigned int entity = 1; entity < 8; ++entity)
+    {
+        a.addComponent(entity, shared);
+    }
+    a.createComponent(8, 2);
+    a.sort([](int x, int y) { return x > y; });
+
+    // owners leave from the front, the back and the middle of the list
+    for (unsigned int entity : {0u, 7u, 3u, 8u})
+    {
+        a.removeComponent(entity);
+    }
+    EXPECT_EQ(a.getOwners(shared), (std::list<unsigned int>{1, 2, 4, 5, 6}));
+
+    a.addComponent(3, shared);
+    a.removeComponent(5);
+    EXPECT_EQ(a.getOwners(shared), (std::list<unsigned int>{1, 2, 4, 6, 3}));
+    EXPECT_EQ(a.getEntities().size(), 5u);
+}
+
 TEST(ECS_COMPONENT_TABLE_TEST, onAdded)
 {
     Engine::ComponentTable<int> a{2};
@@ -121,9 +177,9 @@ TEST(ECS_COMPONENT_TABLE_TEST, onAdded)
 
     int invokeCounter{0};
 
-    // The shared_ptr hold the callback alive; if it goes out of scope or isn't even stored the callback will be cleaned
-    // up
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<int>)>> cb1 = a.onAdded(
+    // The connection keeps the callback alive; if it goes out of scope or isn't even stored the callback will be
+    // cleaned up
+    Engine::Connection cb1 = a.onAdded(
         [&](unsigned int entity, std::weak_ptr<int> component)
         {
             if (entity == 0)
@@ -133,7 +189,7 @@ TEST(ECS_COMPONENT_TABLE_TEST, onAdded)
             invokeCounter++;
         });
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<int>)>> cb2 = a.onAdded(
+    Engine::Connection cb2 = a.onAdded(
         [&](unsigned int entity, std::weak_ptr<int> component)
         {
             if (entity == 1)
@@ -149,7 +205,7 @@ TEST(ECS_COMPONENT_TABLE_TEST, onAdded)
     EXPECT_EQ(addedToSecond, componentA);
     EXPECT_EQ(invokeCounter, 2);
 
-    // check cleanup of callback on deletion of shared_ptr
+    // check cleanup of callback on reset of the connection
     cb1.reset();
 
     a.addComponent(1, componentA);
@@ -169,7 +225,7 @@ TEST(ECS_COMPONENT_TABLE_TEST, onRemove)
 
     int counter{0};
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<int>)>> cb1 = a.onRemove(
+    Engine::Connection cb1 = a.onRemove(
         [&](unsigned int entity, std::weak_ptr<int> component)
         {
             if (entity++ == 0)
@@ -178,7 +234,7 @@ TEST(ECS_COMPONENT_TABLE_TEST, onRemove)
             }
         });
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<int>)>> cb2 = a.onRemove(
+    Engine::Connection cb2 = a.onRemove(
         [&](unsigned int entity, std::weak_ptr<int> component)
         {
             if (counter++ == 1)
@@ -206,7 +262,7 @@ TEST(ECS_COMPONENT_TABLE_TEST, onUpdate)
 
     int counter{0};
 
-    std::shared_ptr<std::function<void(unsigned int, std::weak_ptr<int>)>> cb =
+    Engine::Connection cb =
         a.onUpdate(1, [&](unsigned int entity, std::weak_ptr<int> component) { counter++; });
 
     a.updated(1);
@@ -214,4 +270,159 @@ TEST(ECS_COMPONENT_TABLE_TEST, onUpdate)
     a.updated(0);
 
     EXPECT_EQ(counter, 2);
+}
+
+struct DenseComponent
+{
+    using storage_policy = Engine::dense_storage;
+
+    DenseComponent(int value) : value{value} {}
+
+    int value;
+};
+
+TEST(ECS_COMPONENT_TABLE_TEST, storage_policy)
+{
+    EXPECT_TRUE((std::is_same<Engine::storage_policy<int>::type, Engine::shared_storage>::value));
+    EXPECT_TRUE((std::is_same<Engine::storage_policy<DenseComponent>::type, Engine::dense_storage>::value));
+}
+
+TEST(ECS_COMPONENT_TABLE_TEST, dense_createComponent)
+{
+    Engine::ComponentTable<DenseComponent> a{3};
+
+    Engine::ComponentHandle<DenseComponent> componentA = a.createComponent(0, 1);
+    Engine::ComponentHandle<DenseComponent> componentB = a.createComponent(1, 2);
+
+    EXPECT_EQ(componentA->value, 1);
+    EXPECT_EQ(componentB->value, 2);
+    EXPECT_EQ(a.getComponent(0), componentA);
+    EXPECT_EQ(a.getComponent(2), nullptr);
+
+    // components are shared through their handles
+    a.addComponent(2, componentB);
+    EXPECT_EQ(a.getComponent(2), componentB);
+    EXPECT_EQ(a.getOwners(componentB).size(), 2);
+    EXPECT_EQ(a.getComponents().size(), 2);
+}
+
+TEST(ECS_COMPONENT_TABLE_TEST, dense_handles_are_stable)
+{
+    Engine::ComponentTable<DenseComponent> a{3};
+
+    Engine::ComponentHandle<DenseComponent> componentA = a.createComponent(0, 1);
+    Engine::ComponentHandle<DenseComponent> componentB = a.createComponent(1, 2);
+    Engine::ComponentHandle<DenseComponent> componentC = a.createComponent(2, 3);
+
+    // removing a component moves the following ones inside the storage
+    a.removeComponent(0);
+
+    EXPECT_FALSE(componentA);
+    EXPECT_TRUE(componentA.expired());
+    EXPECT_EQ(componentB->value, 2);
+    EXPECT_EQ(componentC->value, 3);
+    EXPECT_EQ(a.getComponent(2), componentC);
+
+    // a reused slot doesn't revive old handles
+    Engine::ComponentHandle<DenseComponent> componentD = a.createComponent(0, 4);
+    EXPECT_FALSE(componentA);
+    EXPECT_NE(componentA, componentD);
+    EXPECT_EQ(componentD->value, 4);
+}
+
+TEST(ECS_COMPONENT_TABLE_TEST, dense_each)
+{
+    Engine::ComponentTable<DenseComponent> a{3};
+
+    a.createComponent(0, 1);
+    a.createComponent(1, 2);
+    a.addComponent(2, a.getComponent(1));
+
+    const DenseComponent *previous{nullptr};
+    int sum{0};
+    a.each(
+        [&](DenseComponent &component)
+        {
+            // components are packed next to each other
+            if (previous)
+            {
+                EXPECT_EQ(previous + 1, &component);
+            }
+            previous = &component;
+            sum += component.value;
+        });
+
+    EXPECT_EQ(sum, 3);
+}
+
+struct TagComponent
+{
+};
+
+TEST(ECS_COMPONENT_TABLE_TEST, tag_storage)
+{
+    EXPECT_TRUE((std::is_same<Engine::storage_policy<TagComponent>::type, Engine::tag_storage>::value));
+
+    Engine::ComponentTable<TagComponent> a{};
+
+    std::vector<unsigned int> added{};
+    std::vector<unsigned int> removed{};
+    Engine::Connection onAdded = a.onAdded([&](unsigned int entity, TagComponent *) { added.push_back(entity); });
+    Engine::Connection onRemove = a.onRemove([&](unsigned int entity, TagComponent *) { removed.push_back(entity); });
+
+    a.createComponent(3);
+    a.createComponent(200);
+    a.createComponents({5, 3, 7});
+    // adding the tag twice doesn't invoke the callbacks again
+    a.createComponent(5);
+
+    EXPECT_EQ(added, (std::vector<unsigned int>{3, 200, 5, 7}));
+    EXPECT_EQ(a.getEntities(), (std::vector<unsigned int>{3, 200, 5, 7}));
+    EXPECT_TRUE(a.contains(200));
+    EXPECT_FALSE(a.contains(4));
+    EXPECT_FALSE(a.contains(100000));
+    EXPECT_EQ(a.getComponent(4), nullptr);
+    EXPECT_EQ(a.getComponent(3), a.getComponent(7));
+
+    a.removeComponent(200);
+    EXPECT_EQ(removed, std::vector<unsigned int>{200});
+    EXPECT_FALSE(a.hasComponent(200));
+    EXPECT_EQ(a.getEntities(), (std::vector<unsigned int>{3, 7, 5}));
+
+    int counter{0};
+    Engine::Connection onUpdate = a.onUpdate(7, [&](unsigned int, TagComponent *) { ++counter; });
+    a.updated(5);
+    a.updated(7);
+    EXPECT_EQ(counter, 1);
+}
+
+TEST(ECS_COMPONENT_TABLE_TEST, component_refs)
+{
+    Engine::ComponentTable<int> shared{};
+    auto component = shared.createComponent(1, 5);
+    shared.createComponent(2, 6);
+
+    Engine::ComponentRef<int> ref = shared.getRef(1);
+    ASSERT_TRUE(ref);
+    EXPECT_EQ(ref.get(), component.get());
+    *ref = 7;
+    EXPECT_EQ(*component, 7);
+    // no new owners
+    EXPECT_EQ(component.use_count(), 2);
+    EXPECT_FALSE(shared.getRef(3));
+
+    Engine::ComponentTable<DenseComponent> dense{};
+    dense.createComponent(1, 1);
+    dense.createComponent(2, 2);
+    Engine::ComponentRef<DenseComponent> denseRef = dense.getRef(2);
+    EXPECT_EQ(denseRef->value, 2);
+
+#ifndef NDEBUG
+    // the last dense component is moved into the freed spot
+    dense.removeComponent(1);
+    EXPECT_THROW(denseRef.get(), const char *);
+
+    shared.removeComponent(1);
+    EXPECT_THROW(ref.get(), const char *);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <Core/ECS/registry.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct FrozenDense
+{
+    using storage_policy = Engine::dense_storage;
+    FrozenDense(int value) : value{value} {}
+    int value;
+};
+
+struct FrozenTag
+{
+};
+
+TEST(ECS_FROZEN_REGISTRY_TEST, keeps_the_state_at_freezing)
+{
+    Engine::Registry registry{};
+
+    unsigned int entity1 = registry.addEntity();
+    unsigned int entity2 = registry.addEntity();
+    registry.createComponent<int>(entity1, 1);
+    registry.addComponent<int>(entity2, registry.getComponent<int>(entity1));
+    registry.createComponent<FrozenDense>(entity1, 2);
+    registry.createComponent<FrozenTag>(entity2);
+
+    auto frozen = registry.freeze<int, FrozenDense, FrozenTag>();
+
+    unsigned int entity3 = registry.addEntity();
+    registry.createComponent<int>(entity3, 3);
+    registry.createComponent<FrozenDense>(entity3, 4);
+    registry.removeEntity(entity1);
+    registry.removeComponent<FrozenTag>(entity2);
+
+    // shared components stay shared
+    ASSERT_TRUE(frozen.hasComponent<int>(entity1));
+    EXPECT_EQ(frozen.getComponent<int>(entity1), frozen.getComponent<int>(entity2));
+    EXPECT_EQ(*frozen.getComponent<int>(entity1), 1);
+    EXPECT_FALSE(frozen.hasComponent<int>(entity3));
+
+    ASSERT_NE(frozen.getComponent<FrozenDense>(entity1), nullptr);
+    EXPECT_EQ(frozen.getComponent<FrozenDense>(entity1)->value, 2);
+    EXPECT_EQ(frozen.getComponent<FrozenDense>(entity2), nullptr);
+
+    EXPECT_TRUE(frozen.hasComponent<FrozenTag>(entity2));
+    EXPECT_EQ(frozen.getEntities<FrozenTag>(), std::vector<unsigned int>{entity2});
+
+    std::vector<unsigned int> visited{};
+    frozen.each<int, FrozenDense>(
+        [&](unsigned int entity, int &value, FrozenDense &dense)
+        {
+            visited.push_back(entity);
+            EXPECT_EQ(value, 1);
+            EXPECT_EQ(dense.value, 2);
+        });
+    EXPECT_EQ(visited, std::vector<unsigned int>{entity1});
+}
+
+TEST(ECS_FROZEN_REGISTRY_TEST, concurrent_readers)
+{
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities{};
+    for (int i = 0; i < 1000; ++i)
+    {
+        entities.push_back(registry.addEntity());
+        registry.createComponent<int>(entities.back(), i);
+    }
+
+    auto frozen = registry.freeze<int>();
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers{};
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    int *value = frozen.getComponent<int>(entities[i]);
+                    if (!value || *value != i)
+                    {
+                        ++mismatches;
+                    }
+                }
+            });
+    }
+
+    // the live registry keeps changing while the readers run
+    for (unsigned int entity : entities)
+    {
+        registry.removeComponent<int>(entity);
+    }
+
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(mismatches, 0);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <Core/ECS/registry.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(ECS_GROUP_TEST, contains_existing_entities)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+
+    a.createComponent<int>(entityA, 1);
+    a.createComponent<int>(entityB, 2);
+    a.createComponent<std::string>(entityB, "B");
+
+    Engine::Group<int, std::string> &group = a.group<int, std::string>();
+
+    EXPECT_EQ(group.size(), 1);
+    EXPECT_FALSE(group.contains(entityA));
+    EXPECT_TRUE(group.contains(entityB));
+
+    // the same group is returned on every call
+    EXPECT_EQ(&group, &(a.group<int, std::string>()));
+}
+
+TEST(ECS_GROUP_TEST, tracks_changes)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+    unsigned int entityC = a.addEntity();
+
+    Engine::Group<int, std::string> &group = a.group<int, std::string>();
+    EXPECT_EQ(group.size(), 0);
+
+    a.createComponent<int>(entityA, 1);
+    EXPECT_EQ(group.size(), 0);
+
+    a.createComponent<std::string>(entityA, "A");
+    EXPECT_TRUE(group.contains(entityA));
+
+    std::shared_ptr<int> shared = a.createComponent<int>(entityB, 2);
+    a.addComponent<int>(entityC, shared);
+    a.createComponent<std::string>(entityB, "B");
+    a.createComponent<std::string>(entityC, "C");
+    EXPECT_EQ(group.size(), 3);
+
+    // swapping a component keeps the entity in the group
+    a.addComponent<int>(entityA, shared);
+    EXPECT_TRUE(group.contains(entityA));
+
+    a.removeComponent<std::string>(entityB);
+    EXPECT_FALSE(group.contains(entityB));
+
+    a.removeEntity(entityA);
+    EXPECT_FALSE(group.contains(entityA));
+
+    std::string names{};
+    group.each(
+        [&](unsigned int entity, int &number, std::string &name)
+        {
+            EXPECT_EQ(entity, entityC);
+            EXPECT_EQ(number, 2);
+            names += name;
+        });
+
+    EXPECT_EQ(group.size(), 1);
+    EXPECT_EQ(names, "C");
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <Core/ECS/registry.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+TEST(ECS_OBSERVER_TEST, collects_matching_entities)
+{
+    Engine::Registry registry{};
+
+    unsigned int before = registry.addEntity();
+    registry.createComponent<int>(before, 0);
+    registry.createComponent<float>(before, 0.0f);
+
+    auto observer = registry.observe<int, float>();
+
+    // entities matching on creation count as entered
+    EXPECT_EQ(observer->getEntered(), std::vector<unsigned int>{before});
+
+    unsigned int entity = registry.addEntity();
+    registry.createComponent<int>(entity, 1);
+    EXPECT_EQ(observer->getEntered().size(), 1u);
+    registry.createComponent<float>(entity, 1.0f);
+    // swapping a component out doesn't change anything
+    registry.createComponent<float>(entity, 2.0f);
+
+    std::vector<unsigned int> left{};
+    std::vector<unsigned int> entered{};
+    auto drain = [&]()
+    {
+        left.clear();
+        entered.clear();
+        observer->drain([&](unsigned int entity) { left.push_back(entity); },
+                        [&](unsigned int entity) { entered.push_back(entity); });
+    };
+
+    drain();
+    std::sort(entered.begin(), entered.end());
+    EXPECT_EQ(entered, (std::vector<unsigned int>{before, entity}));
+    EXPECT_TRUE(left.empty());
+    EXPECT_TRUE(observer->empty());
+
+    // entities that enter and leave between two drains are dropped
+    unsigned int shortLived = registry.addEntity();
+    registry.createComponent<int>(shortLived, 2);
+    registry.createComponent<float>(shortLived, 2.0f);
+    registry.removeEntity(shortLived);
+
+    registry.removeComponent<int>(entity);
+    registry.createComponent<int>(entity, 3);
+    registry.removeComponent<float>(before);
+
+    drain();
+    std::sort(left.begin(), left.end());
+    EXPECT_EQ(left, (std::vector<unsigned int>{before, entity}));
+    EXPECT_EQ(entered, std::vector<unsigned int>{entity});
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include <Core/ECS/registry.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <exception>
+#include <list>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 TEST(ECS_REGISTRY_TEST, instanciable) { Engine::Registry a{}; }
 
@@ -31,6 +36,42 @@ TEST(ECS_REGISTRY_TEST, removeEntity)
     EXPECT_EQ(newEnt, 2);
 }
 
+TEST(ECS_REGISTRY_TEST, entityHandles)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+    Engine::EntityHandle handleA = a.getHandle(entityA);
+
+    EXPECT_TRUE(a.isAlive(handleA));
+
+    a.removeEntity(entityA);
+    EXPECT_FALSE(a.isAlive(entityA));
+    EXPECT_FALSE(a.isAlive(handleA));
+
+    // removing an unused entity changes nothing
+    a.removeEntity(entityA);
+
+    unsigned int reused = a.addEntity();
+    EXPECT_EQ(reused, entityA);
+    EXPECT_TRUE(a.isAlive(reused));
+    // the old handle doesn't alias the new entity
+    EXPECT_FALSE(a.isAlive(handleA));
+    EXPECT_NE(a.getHandle(reused), handleA);
+
+    // the id was only freed once
+    EXPECT_EQ(a.addEntity(), 2);
+
+    EXPECT_ANY_THROW(a.getHandle(5));
+
+    a.createComponent<int>(entityB, 1);
+    a.clear();
+    EXPECT_TRUE(a.getEntities().empty());
+    EXPECT_FALSE(a.isAlive(entityB));
+    EXPECT_EQ(a.getComponents<int>().size(), 0);
+}
+
 TEST(ECS_REGISTRY_TEST, addComponent)
 {
     // you are able to add any type of Component to an entity
@@ -162,4 +203,501 @@ TEST(ECS_REGISTRY_TEST, getGroupedComponents)
     EXPECT_EQ(groupStrInt[1].second.size(), 2);
     EXPECT_EQ(groupStrInt[1].second[0], int1);
     EXPECT_EQ(groupStrInt[1].second[1], int2);
+}
+
+struct DenseRegistryComponent
+{
+    using storage_policy = Engine::dense_storage;
+
+    DenseRegistryComponent(float value) : value{value} {}
+
+    float value;
+};
+
+TEST(ECS_REGISTRY_TEST, denseComponents)
+{
+    Engine::Registry a{};
+
+    int entityA = a.addEntity();
+    int entityB = a.addEntity();
+
+    Engine::ComponentHandle<DenseRegistryComponent> component =
+        a.createComponent<DenseRegistryComponent>(entityA, 1.0f);
+    a.addComponent<DenseRegistryComponent>(entityB, component);
+
+    EXPECT_EQ(a.getComponent<DenseRegistryComponent>(entityB), component);
+    EXPECT_EQ(a.getComponents<DenseRegistryComponent>().size(), 1);
+
+    int updates{0};
+    auto cb = a.onUpdate<DenseRegistryComponent>(
+        [&](unsigned int entity, Engine::ComponentHandle<DenseRegistryComponent> updated)
+        {
+            (void)entity;
+            EXPECT_EQ(updated.lock()->value, 2.0f);
+            ++updates;
+        });
+
+    component->value = 2.0f;
+    a.updated<DenseRegistryComponent>(entityB);
+    EXPECT_EQ(updates, 1);
+
+    a.removeComponent<DenseRegistryComponent>(entityA);
+    a.removeComponent<DenseRegistryComponent>(entityB);
+    EXPECT_FALSE(component);
+}
+
+TEST(ECS_REGISTRY_TEST, deferredUpdates)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+    unsigned int entityC = a.addEntity();
+    a.createComponent<int>(entityA, 1);
+    a.createComponent<int>(entityB, 2);
+    a.createComponent<int>(entityC, 3);
+    a.createComponent<float>(entityA, 1.0f);
+
+    std::vector<std::string> calls{};
+    auto intCB = a.onUpdate<int>([&](unsigned int entity, std::weak_ptr<int>)
+                                 { calls.push_back("int" + std::to_string(entity)); });
+    auto floatCB = a.onUpdate<float>([&](unsigned int entity, std::weak_ptr<float>)
+                                     { calls.push_back("float" + std::to_string(entity)); });
+
+    a.deferUpdates();
+    EXPECT_TRUE(a.isDeferringUpdates());
+
+    a.updated<int>(entityB);
+    a.updated<float>(entityA);
+    a.updated<int>(entityA);
+    a.updated<int>(entityB);
+    a.updated<int>(entityC);
+    a.removeComponent<int>(entityC);
+
+    EXPECT_TRUE(calls.empty());
+
+    a.flushUpdates();
+    EXPECT_FALSE(a.isDeferringUpdates());
+
+    // coalesced in the order of the first update and without the removed component
+    std::vector<std::string> expected{"int1", "float0", "int0"};
+    EXPECT_EQ(calls, expected);
+
+    // updates of removed entities are dropped even if the id was reused
+    calls.clear();
+    a.deferUpdates();
+    a.updated<int>(entityB);
+    a.removeEntity(entityB);
+    unsigned int reused = a.addEntity();
+    a.createComponent<int>(reused, 4);
+    a.flushUpdates();
+
+    EXPECT_TRUE(calls.empty());
+
+    a.updated<int>(reused);
+    EXPECT_EQ(calls.size(), 1);
+}
+
+TEST(ECS_REGISTRY_TEST, bulkCreation)
+{
+    Engine::Registry a{};
+
+    std::vector<unsigned int> entities = a.addEntities(4);
+    ASSERT_EQ(entities.size(), 4);
+    EXPECT_EQ(entities[3], 3);
+
+    a.createComponent<std::string>(entities[1], "old");
+
+    unsigned int storedOnAdd{0};
+    unsigned int added{0};
+    unsigned int swapped{0};
+    std::vector<unsigned int> range{};
+    auto addCB = a.onAdded<std::string>(
+        [&](unsigned int, std::weak_ptr<std::string>)
+        {
+            // every component is stored before the first callback is invoked
+            storedOnAdd = a.getComponents<std::string>().size();
+            ++added;
+        });
+    auto swapCB = a.onComponentSwap<std::string>([&](unsigned int, std::weak_ptr<std::string>) { ++swapped; });
+    auto rangeCB = a.onAddedRange<std::string>([&](const std::vector<unsigned int> &entities) { range = entities; });
+
+    std::vector<std::shared_ptr<std::string>> created = a.createComponents<std::string>(entities, "name");
+
+    ASSERT_EQ(created.size(), 4);
+    EXPECT_EQ(*created[2], "name");
+    EXPECT_EQ(a.getComponent<std::string>(entities[1]), created[1]);
+    EXPECT_EQ(a.getComponents<std::string>().size(), 4);
+
+    EXPECT_EQ(added, 3);
+    EXPECT_EQ(storedOnAdd, 4);
+    EXPECT_EQ(swapped, 1);
+    std::vector<unsigned int> expected{entities[0], entities[2], entities[3]};
+    EXPECT_EQ(range, expected);
+
+    EXPECT_ANY_THROW(a.createComponents<std::string>({0, 7}, "name"));
+}
+
+TEST(ECS_REGISTRY_TEST, changedSince)
+{
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(4);
+    for (unsigned int entity : entities)
+    {
+        registry.createComponent<int>(entity, 0);
+    }
+
+    // added components count as changes
+    EXPECT_EQ(registry.changedSince<int>(0).size(), 4u);
+
+    unsigned long long tick = registry.getChangeTick<int>();
+    EXPECT_TRUE(registry.changedSince<int>(tick).empty());
+
+    registry.updated<int>(entities[2]);
+    registry.updated<int>(entities[0]);
+    registry.updated<int>(entities[2]);
+
+    std::vector<unsigned int> changed = registry.changedSince<int>(tick);
+    std::sort(changed.begin(), changed.end());
+    EXPECT_EQ(changed, (std::vector<unsigned int>{entities[0], entities[2]}));
+    EXPECT_TRUE(registry.changedSince<int>(entities[2], tick));
+    EXPECT_FALSE(registry.changedSince<int>(entities[1], tick));
+
+    // the ticks move with the components when another component is removed
+    registry.removeComponent<int>(entities[1]);
+    EXPECT_TRUE(registry.changedSince<int>(entities[2], tick));
+    EXPECT_FALSE(registry.changedSince<int>(entities[3], tick));
+    EXPECT_FALSE(registry.changedSince<int>(entities[1], tick));
+
+    // deferred updates change the tick once they are dispatched
+    tick = registry.getChangeTick<int>();
+    registry.deferUpdates();
+    registry.updated<int>(entities[3]);
+    EXPECT_TRUE(registry.changedSince<int>(tick).empty());
+    registry.flushUpdates();
+    EXPECT_EQ(registry.changedSince<int>(tick), std::vector<unsigned int>{entities[3]});
+}
+
+TEST(ECS_REGISTRY_TEST, basicRegistry)
+{
+    // int and std::string are declared up front while float gets its table on first use
+    Engine::BasicRegistry<Engine::entity_config32, int, std::string> registry{};
+
+    unsigned int entity = registry.addEntity();
+    registry.createComponent<int>(entity, 1);
+    registry.createComponent<std::string>(entity, "name");
+    registry.createComponent<float>(entity, 0.5f);
+
+    EXPECT_EQ(*registry.getComponent<int>(entity), 1);
+    EXPECT_EQ(*registry.getComponent<std::string>(entity), "name");
+    EXPECT_EQ(*registry.getComponent<float>(entity), 0.5f);
+
+    std::vector<unsigned int> updated{};
+    Engine::Connection intUpdates =
+        registry.onUpdate<int>([&](unsigned int entity, std::weak_ptr<int>) { updated.push_back(entity); });
+    Engine::Connection floatUpdates =
+        registry.onUpdate<float>([&](unsigned int entity, std::weak_ptr<float>) { updated.push_back(entity + 10); });
+
+    registry.deferUpdates();
+    registry.updated<float>(entity);
+    registry.updated<int>(entity);
+    registry.flushUpdates();
+    EXPECT_EQ(updated, (std::vector<unsigned int>{entity + 10, entity}));
+
+    // removing the entity removes the components of declared and undeclared types
+    std::vector<unsigned int> removed{};
+    Engine::Connection intRemoves =
+        registry.onRemove<int>([&](unsigned int entity, std::weak_ptr<int>) { removed.push_back(entity); });
+    Engine::Connection floatRemoves =
+        registry.onRemove<float>([&](unsigned int entity, std::weak_ptr<float>) { removed.push_back(entity); });
+    registry.removeEntity(entity);
+
+    EXPECT_EQ(removed.size(), 2u);
+    EXPECT_FALSE(registry.hasComponent<int>(entity));
+    EXPECT_FALSE(registry.hasComponent<float>(entity));
+}
+
+struct NamedComponent
+{
+    std::string name;
+    int value;
+};
+
+template <>
+struct Engine::snapshot_traits<NamedComponent>
+{
+    static void write(SnapshotWriter &writer, NamedComponent &component)
+    {
+        writer.writeString(component.name);
+        writer.write(component.value);
+    }
+
+    static NamedComponent read(SnapshotReader &reader)
+    {
+        std::string name{reader.readString()};
+        return NamedComponent{name, reader.read<int>()};
+    }
+};
+
+struct SnapshotTag
+{
+};
+
+TEST(ECS_REGISTRY_TEST, snapshot)
+{
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(5);
+    registry.removeEntity(entities[1]);
+    Engine::EntityHandle removed{entities[1], 0};
+
+    registry.createComponent<int>(entities[0], 1);
+    auto shared = registry.createComponent<int>(entities[2], 2);
+    registry.addComponent<int>(entities[3], shared);
+    registry.createComponent<NamedComponent>(entities[4], NamedComponent{"named", 4});
+    registry.createComponent<SnapshotTag>(entities[2]);
+    registry.createComponent<SnapshotTag>(entities[0]);
+    Engine::EntityHandle handle = registry.getHandle(entities[4]);
+
+    std::string data = registry.snapshot<int, NamedComponent, SnapshotTag>();
+
+    Engine::Registry restored{};
+    restored.createComponent<int>(restored.addEntity(), 10);
+    std::vector<unsigned int> added{};
+    Engine::Connection onAdded =
+        restored.onAdded<int>([&](unsigned int entity, std::weak_ptr<int>) { added.push_back(entity); });
+
+    restored.restore<int, NamedComponent, SnapshotTag>(data);
+
+    EXPECT_EQ(restored.getEntities(), registry.getEntities());
+    EXPECT_TRUE(restored.isAlive(handle));
+    EXPECT_FALSE(restored.isAlive(removed));
+    // freed ids are handed out in the same order
+    EXPECT_EQ(restored.addEntity(), registry.addEntity());
+
+    EXPECT_EQ(*restored.getComponent<int>(entities[0]), 1);
+    EXPECT_EQ(*restored.getComponent<int>(entities[2]), 2);
+    EXPECT_EQ(restored.getComponent<int>(entities[2]), restored.getComponent<int>(entities[3]));
+    EXPECT_EQ(restored.getComponent<NamedComponent>(entities[4])->name, "named");
+    EXPECT_EQ(restored.getComponent<NamedComponent>(entities[4])->value, 4);
+    EXPECT_TRUE(restored.hasComponent<SnapshotTag>(entities[0]));
+    EXPECT_TRUE(restored.hasComponent<SnapshotTag>(entities[2]));
+    EXPECT_FALSE(restored.hasComponent<SnapshotTag>(entities[3]));
+
+    // restored components are added through the usual callbacks
+    EXPECT_EQ(added.size(), 3u);
+
+    EXPECT_THROW(restored.restore<int>(data), const char *);
+    EXPECT_THROW(restored.restore<int>(data.data(), 4), const char *);
+}
+
+TEST(ECS_REGISTRY_TEST, failed_restore_keeps_the_registry)
+{
+    Engine::Registry registry{};
+    std::vector<unsigned int> entities = registry.addEntities(3);
+    registry.createComponent<int>(entities[0], 1);
+    registry.createComponent<NamedComponent>(entities[1], NamedComponent{"named", 2});
+    std::string data = registry.snapshot<int, NamedComponent>();
+
+    Engine::Registry restored{};
+    unsigned int entity = restored.addEntity();
+    restored.createComponent<int>(entity, 10);
+
+    auto unchanged = [&]()
+    {
+        EXPECT_EQ(restored.getEntities(), std::list<unsigned int>{entity});
+        EXPECT_EQ(*restored.getComponent<int>(entity), 10);
+    };
+
+    // the header matches but the size tag of the second type doesn't
+    EXPECT_THROW((restored.restore<int, int>(data)), const char *);
+    unchanged();
+
+    // the snapshot ends in the middle of the last component
+    EXPECT_THROW((restored.restore<int, NamedComponent>(data.data(), data.size() - 1)), const char *);
+    unchanged();
+
+    // trailing bytes
+    EXPECT_THROW((restored.restore<int, NamedComponent>(data + "x")), const char *);
+    unchanged();
+
+    restored.restore<int, NamedComponent>(data);
+    EXPECT_EQ(restored.getEntities(), registry.getEntities());
+    EXPECT_EQ(restored.getComponent<NamedComponent>(entities[1])->name, "named");
+}
+
+TEST(ECS_REGISTRY_TEST, sort)
+{
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(5);
+    int values[]{3, 1, 4, 0, 2};
+    for (unsigned int i = 0; i < entities.size(); ++i)
+    {
+        registry.createComponent<int>(entities[i], values[i]);
+        registry.createComponent<DenseRegistryComponent>(entities[4 - i], values[i]);
+    }
+    registry.createComponent<SnapshotTag>(entities[2]);
+    registry.createComponent<SnapshotTag>(entities[0]);
+    // shared components stay shared
+    registry.addComponent<int>(entities[1], std::make_shared<int>(-1));
+    registry.addComponent<int>(entities[3], registry.getComponent<int>(entities[1]));
+    auto dense = registry.getComponent<DenseRegistryComponent>(entities[2]);
+    int denseUpdates = 0;
+    auto connection =
+        registry.onUpdate<DenseRegistryComponent>(entities[2], [&](unsigned int, auto) { ++denseUpdates; });
+
+    registry.sort<int>([](const int &a, const int &b) { return a < b; });
+
+    std::vector<int> sorted{};
+    registry.view<int>().each([&](unsigned int, int &value) { sorted.push_back(value); });
+    EXPECT_EQ(sorted, (std::vector<int>{-1, -1, 2, 3, 4}));
+    EXPECT_EQ(registry.getComponent<int>(entities[1]), registry.getComponent<int>(entities[3]));
+    EXPECT_EQ(*registry.getComponent<int>(entities[4]), 2);
+
+    registry.sortAs<DenseRegistryComponent, int>();
+    registry.sortAs<SnapshotTag, int>();
+
+    EXPECT_EQ(registry.getEntities<DenseRegistryComponent>(), registry.getEntities<int>());
+    EXPECT_EQ(registry.getEntities<SnapshotTag>(), (std::vector<unsigned int>{entities[0], entities[2]}));
+    for (unsigned int entity : entities)
+    {
+        EXPECT_EQ(registry.getComponent<DenseRegistryComponent>(entity)->value,
+                  values[4 - std::distance(entities.begin(), std::find(entities.begin(), entities.end(), entity))]);
+    }
+
+    // handles and update callbacks follow their components
+    EXPECT_EQ(dense->value, 4);
+    registry.updated<DenseRegistryComponent>(entities[2]);
+    EXPECT_EQ(denseUpdates, 1);
+}
+
+
+TEST(ECS_REGISTRY_TEST, smallRegistry)
+{
+    Engine::SmallRegistry registry{};
+
+    EXPECT_TRUE((std::is_same<Engine::SmallRegistry::entity_type, std::uint16_t>::value));
+    EXPECT_TRUE((std::is_same<std::remove_reference_t<decltype(registry.getEntities<int>())>,
+                              const std::vector<std::uint16_t>>::value));
+
+    std::vector<unsigned int> entities = registry.addEntities(3);
+    registry.createComponent<int>(entities[0], 1);
+    registry.createComponent<int>(entities[2], 3);
+    registry.createComponent<float>(entities[2], 3.0f);
+    registry.createComponent<SnapshotTag>(entities[1]);
+
+    unsigned int visited = 0;
+    registry.view<int, float>().each(
+        [&](unsigned int entity, int &value, float &)
+        {
+            EXPECT_EQ(entity, entities[2]);
+            EXPECT_EQ(value, 3);
+            ++visited;
+        });
+    EXPECT_EQ(visited, 1u);
+    EXPECT_EQ((registry.group<int, float>().size()), 1u);
+    EXPECT_EQ(registry.observe<int>()->getEntered().size(), 2u);
+    EXPECT_EQ(*registry.freeze<int>().getComponent<int>(entities[2]), 3);
+
+    std::string data = registry.snapshot<int, SnapshotTag>();
+    Engine::SmallRegistry restored{};
+    restored.restore<int, SnapshotTag>(data);
+    EXPECT_EQ(*restored.getComponent<int>(entities[0]), 1);
+    EXPECT_TRUE(restored.hasComponent<SnapshotTag>(entities[1]));
+
+    // snapshots only restore into registries with the same entity type
+    Engine::Registry wide{};
+    EXPECT_THROW((wide.restore<int, SnapshotTag>(data)), const char *);
+
+    registry.addEntities(Engine::entity_config16::maxEntities - 3);
+    EXPECT_THROW(registry.addEntity(), const char *);
+}
+
+TEST(ECS_REGISTRY_TEST, instantiate)
+{
+    Engine::Registry registry{};
+
+    unsigned int prefab = registry.addEntity();
+    auto mesh = registry.createComponent<std::string>(prefab, "mesh");
+    registry.createComponent<DenseRegistryComponent>(prefab, 1.0f);
+    registry.createComponent<SnapshotTag>(prefab);
+
+    std::vector<unsigned int> instances =
+        registry.instantiate<std::string, DenseRegistryComponent, SnapshotTag>(prefab, 3);
+    ASSERT_EQ(instances.size(), 3u);
+    EXPECT_EQ(registry.getOwners<std::string>(prefab).size(), 4u);
+    EXPECT_EQ(registry.getOwners<DenseRegistryComponent>(prefab).size(), 4u);
+    EXPECT_TRUE(registry.hasComponent<SnapshotTag>(instances[2]));
+    EXPECT_EQ(registry.getComponent<std::string>(instances[0]), mesh);
+    // types the prefab doesn't own are skipped
+    EXPECT_TRUE(registry.instantiate<int>(prefab, 1).size() == 1);
+
+    unsigned int swaps = 0;
+    auto connection = registry.onComponentSwap<std::string>([&](unsigned int, auto) { ++swaps; });
+
+    // the first write clones the component for the instance
+    auto unique = registry.getUniqueComponent<std::string>(instances[0]);
+    *unique = "edited";
+    EXPECT_NE(unique, mesh);
+    EXPECT_EQ(*mesh, "mesh");
+    EXPECT_EQ(*registry.getComponent<std::string>(instances[1]), "mesh");
+    EXPECT_EQ(registry.getOwners<std::string>(prefab).size(), 3u);
+    EXPECT_EQ(swaps, 1u);
+
+    // an unshared component is written in place
+    EXPECT_EQ(registry.getUniqueComponent<std::string>(instances[0]), unique);
+    EXPECT_EQ(swaps, 1u);
+
+    auto dense = registry.getUniqueComponent<DenseRegistryComponent>(instances[1]);
+    dense->value = 2.0f;
+    EXPECT_EQ(registry.getComponent<DenseRegistryComponent>(prefab)->value, 1.0f);
+    EXPECT_EQ(registry.getComponent<DenseRegistryComponent>(instances[1])->value, 2.0f);
+
+    EXPECT_EQ(registry.getUniqueComponent<std::string>(registry.addEntity()), nullptr);
+}
+
+TEST(ECS_REGISTRY_TEST, stats)
+{
+    Engine::BasicRegistry<Engine::entity_config32, float> registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(3);
+    auto shared = registry.createComponent<int>(entities[0], 1);
+    registry.addComponent<int>(entities[1], shared);
+    registry.createComponent<int>(entities[2], 2);
+    registry.createComponent<SnapshotTag>(entities[2]);
+    auto connection = registry.onUpdate<int>([](unsigned int, auto) {});
+    registry.updated<int>(entities[0]);
+    registry.updated<int>(entities[2]);
+    registry.removeComponent<int>(entities[2]);
+
+    Engine::RegistryStats stats = registry.stats(true);
+    EXPECT_EQ(stats.numEntities, 3u);
+    ASSERT_EQ(stats.tables.size(), 3u);
+    // declared types come first
+    EXPECT_EQ(stats.tables[0].name, "float");
+    EXPECT_EQ(stats.tables[0].numComponents, 0u);
+
+    auto intStats = std::find_if(stats.tables.begin(),
+                                 stats.tables.end(),
+                                 [](const Engine::ComponentTableStats &table) { return table.name == "int"; });
+    ASSERT_NE(intStats, stats.tables.end());
+    EXPECT_EQ(intStats->numComponents, 1u);
+    EXPECT_EQ(intStats->numOwners, 2u);
+    EXPECT_EQ(intStats->numCallbacks, 1u);
+    EXPECT_EQ(intStats->numAdded, 3u);
+    EXPECT_EQ(intStats->numRemoved, 1u);
+    EXPECT_EQ(intStats->numUpdated, 2u);
+    EXPECT_GT(intStats->sparseCapacity, 0u);
+    EXPECT_GT(intStats->memory, 0u);
+
+    // the event counts were reset
+    registry.updated<int>(entities[0]);
+    stats = registry.stats();
+    intStats = std::find_if(stats.tables.begin(),
+                            stats.tables.end(),
+                            [](const Engine::ComponentTableStats &table) { return table.name == "int"; });
+    EXPECT_EQ(intStats->numAdded, 0u);
+    EXPECT_EQ(intStats->numUpdated, 1u);
 }
\ No newline at end of file
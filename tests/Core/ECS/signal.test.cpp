@@ -0,0 +1,90 @@
+#include <Core/ECS/signal.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(ECS_SIGNAL_TEST, connect)
+{
+    Engine::Signal<void(int)> signal{};
+
+    std::vector<int> calls{};
+    Engine::Connection first = signal.connect([&](int value) { calls.push_back(value); });
+    Engine::Connection second = signal.connect([&](int value) { calls.push_back(value * 10); });
+
+    signal(1);
+
+    std::vector<int> expected{1, 10};
+    EXPECT_EQ(calls, expected);
+    EXPECT_TRUE(first.connected());
+
+    // resetting or reassigning a connection disconnects the callback
+    first.reset();
+    EXPECT_FALSE(first.connected());
+    second = Engine::Connection{};
+
+    signal(2);
+    EXPECT_EQ(calls, expected);
+
+    // connections that aren't held disconnect right away
+    signal.connect([&](int value) { calls.push_back(value); });
+    signal(3);
+    EXPECT_EQ(calls, expected);
+}
+
+TEST(ECS_SIGNAL_TEST, reused_slots)
+{
+    Engine::Signal<void()> signal{};
+
+    int counter{0};
+    Engine::Connection old = signal.connect([&]() { ++counter; });
+    Engine::SlotId oldId = old.id();
+    old.reset();
+
+    Engine::Connection current = signal.connect([&]() { counter += 10; });
+
+    // the slot was reused but the old id doesn't match the new callback
+    EXPECT_EQ(current.id().slot, oldId.slot);
+    EXPECT_FALSE(signal.connected(oldId));
+    signal.invoke(oldId);
+    EXPECT_EQ(counter, 0);
+
+    signal.disconnect(oldId);
+    signal();
+    EXPECT_EQ(counter, 10);
+}
+
+TEST(ECS_SIGNAL_TEST, change_while_invoking)
+{
+    Engine::Signal<void()> signal{};
+
+    int counter{0};
+    Engine::Connection self{};
+    Engine::Connection added{};
+    self = signal.connect(
+        [&]()
+        {
+            ++counter;
+            // disconnects the running callback
+            self.reset();
+            added = signal.connect([&]() { counter += 10; });
+        });
+
+    signal();
+    EXPECT_EQ(counter, 1);
+
+    signal();
+    EXPECT_EQ(counter, 11);
+}
+
+TEST(ECS_SIGNAL_TEST, outlives_signal)
+{
+    Engine::Connection connection{};
+    {
+        Engine::Signal<void()> signal{};
+        connection = signal.connect([]() {});
+        EXPECT_TRUE(connection.connected());
+    }
+
+    EXPECT_FALSE(connection.connected());
+    connection.reset();
+}
\ No newline at end of file
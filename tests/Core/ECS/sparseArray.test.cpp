@@ -0,0 +1,32 @@
+#include <Core/ECS/sparseArray.h>
+#include <gtest/gtest.h>
+
+TEST(ECS_SPARSE_ARRAY_TEST, pages)
+{
+    Engine::PagedSparseArray<int, 64> array{-1};
+
+    // reading never allocates
+    EXPECT_EQ(array.get(1000000), -1);
+    EXPECT_EQ(array.getNumPages(), 0u);
+
+    array.set(1000000, 3);
+    array.set(1000001, 4);
+    array.set(5, 0);
+    EXPECT_EQ(array.get(1000000), 3);
+    EXPECT_EQ(array.get(1000001), 4);
+    EXPECT_EQ(array.get(1000002), -1);
+    EXPECT_EQ(array.get(5), 0);
+    EXPECT_EQ(array.getNumPages(), 2u);
+
+    // writing the empty value into a missing page doesn't allocate it
+    array.set(500, -1);
+    EXPECT_EQ(array.getNumPages(), 2u);
+
+    // pages are freed once all their values are empty again
+    array.set(1000000, -1);
+    EXPECT_EQ(array.getNumPages(), 2u);
+    array.set(1000001, -1);
+    EXPECT_EQ(array.getNumPages(), 1u);
+    EXPECT_EQ(array.get(1000001), -1);
+    EXPECT_EQ(array.get(5), 0);
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <Core/ECS/registry.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(ECS_VIEW_TEST, each)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+    unsigned int entityC = a.addEntity();
+
+    a.createComponent<int>(entityA, 1);
+    a.createComponent<int>(entityB, 2);
+    a.createComponent<int>(entityC, 3);
+
+    a.createComponent<std::string>(entityB, "B");
+    a.createComponent<std::string>(entityC, "C");
+
+    int sum{0};
+    std::string names{};
+    a.view<int, std::string>().each(
+        [&](unsigned int entity, int &number, std::string &name)
+        {
+            EXPECT_NE(entity, entityA);
+            sum += number;
+            names += name;
+        });
+
+    EXPECT_EQ(sum, 5);
+    EXPECT_EQ(names.size(), 2);
+}
+
+TEST(ECS_VIEW_TEST, iterator)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+
+    a.createComponent<int>(entityA, 1);
+    std::shared_ptr<int> shared = a.createComponent<int>(entityB, 2);
+    a.addComponent<int>(entityA, shared);
+
+    a.createComponent<float>(entityB, 0.5f);
+
+    unsigned int visited{0};
+    for (auto [entity, number, floatNumber] : a.view<int, float>())
+    {
+        EXPECT_EQ(entity, entityB);
+        EXPECT_EQ(number, 2);
+        EXPECT_EQ(floatNumber, 0.5f);
+
+        // references point into the registry
+        floatNumber = 1.5f;
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, 1);
+    EXPECT_EQ(*a.getComponent<float>(entityB), 1.5f);
+}
+
+TEST(ECS_VIEW_TEST, tracks_removal)
+{
+    Engine::Registry a{};
+
+    unsigned int entityA = a.addEntity();
+    unsigned int entityB = a.addEntity();
+
+    a.createComponent<int>(entityA, 1);
+    a.createComponent<int>(entityB, 2);
+    a.createComponent<char>(entityA, 'a');
+    a.createComponent<char>(entityB, 'b');
+
+    a.removeComponent<int>(entityA);
+
+    std::vector<unsigned int> entities{};
+    a.view<int, char>().each([&](unsigned int entity, int &, char &) { entities.push_back(entity); });
+
+    ASSERT_EQ(entities.size(), 1);
+    EXPECT_EQ(entities[0], entityB);
+
+    // empty views don't visit anything
+    auto emptyView = a.view<int, double>();
+    EXPECT_TRUE(emptyView.begin() == emptyView.end());
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <Core/ECS/worldGrid.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+struct GridPosition
+{
+    float x;
+    float z;
+};
+
+struct GridTag
+{
+};
+
+using TestGrid = Engine::WorldGrid<GridPosition, GridPosition, int, GridTag>;
+
+static std::pair<float, float> locate(GridPosition &position) { return {position.x, position.z}; }
+
+static std::filesystem::path gridDirectory()
+{
+    std::filesystem::path directory{std::filesystem::temp_directory_path() / "worldGridTest"};
+    std::filesystem::remove_all(directory);
+    return directory;
+}
+
+TEST(ECS_WORLD_GRID_TEST, streams_cells_around_the_camera)
+{
+    std::filesystem::path directory{gridDirectory()};
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(3);
+    registry.createComponent<GridPosition>(entities[0], GridPosition{1.0f, 1.0f});
+    registry.createComponent<GridPosition>(entities[1], GridPosition{9.0f, 2.0f});
+    registry.createComponent<GridPosition>(entities[2], GridPosition{55.0f, 3.0f});
+    registry.createComponent<int>(entities[0], 1);
+    registry.addComponent<int>(entities[1], registry.getComponent<int>(entities[0]));
+    registry.createComponent<int>(entities[2], 2);
+    registry.createComponent<GridTag>(entities[1]);
+
+    {
+        TestGrid grid{registry, directory, 10.0f, locate, 1024};
+        grid.partition(entities);
+
+        EXPECT_TRUE(registry.getEntities().empty());
+        EXPECT_EQ(grid.getResidentSize(), 0u);
+    }
+    // the chunks are written once the grid is gone
+    EXPECT_TRUE(std::filesystem::exists(directory / "cell_0_0.chunk"));
+    EXPECT_TRUE(std::filesystem::exists(directory / "cell_5_0.chunk"));
+
+    // a new grid picks up the chunks of the directory
+    TestGrid grid{registry, directory, 10.0f, locate, 1024};
+
+    grid.update(2.0f, 2.0f);
+    grid.finishLoading();
+    EXPECT_TRUE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{5, 0}));
+    EXPECT_GT(grid.getResidentSize(), 0u);
+
+    // shared components stay shared
+    const std::vector<Engine::EntityHandle> &loaded = grid.getEntities(Engine::CellCoord{0, 0});
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(registry.getEntities().size(), 2u);
+    EXPECT_EQ(registry.getComponent<int>(loaded[0].id), registry.getComponent<int>(loaded[1].id));
+    EXPECT_EQ(*registry.getComponent<int>(loaded[0].id), 1);
+    EXPECT_FALSE(registry.hasComponent<GridTag>(loaded[0].id));
+    EXPECT_TRUE(registry.hasComponent<GridTag>(loaded[1].id));
+
+    // edits are written when the cell is unloaded
+    registry.getComponent<GridPosition>(loaded[0].id)->z = 5.0f;
+    registry.removeEntity(loaded[1].id);
+
+    grid.update(52.0f, 2.0f);
+    grid.finishLoading();
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_TRUE(grid.isLoaded(Engine::CellCoord{5, 0}));
+    ASSERT_EQ(registry.getEntities().size(), 1u);
+    EXPECT_EQ(*registry.getComponent<int>(registry.getEntities().front()), 2);
+
+    grid.update(2.0f, 2.0f);
+    grid.finishLoading();
+    ASSERT_EQ(grid.getEntities(Engine::CellCoord{0, 0}).size(), 1u);
+    unsigned int edited = grid.getEntities(Engine::CellCoord{0, 0}).front().id;
+    EXPECT_EQ(registry.getComponent<GridPosition>(edited)->z, 5.0f);
+}
+
+TEST(ECS_WORLD_GRID_TEST, memory_budget)
+{
+    std::filesystem::path directory{gridDirectory()};
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(2);
+    registry.createComponent<GridPosition>(entities[0], GridPosition{1.0f, 1.0f});
+    registry.createComponent<GridPosition>(entities[1], GridPosition{11.0f, 1.0f});
+
+    TestGrid grid{registry, directory, 10.0f, locate, 0};
+    grid.partition(entities);
+
+    // nothing fits into the budget
+    grid.update(1.0f, 1.0f);
+    grid.finishLoading();
+    EXPECT_TRUE(registry.getEntities().empty());
+
+    grid.setRadius(0, 0);
+    grid.setMemoryBudget(1024);
+    grid.update(1.0f, 1.0f);
+    grid.finishLoading();
+    std::size_t chunkSize = grid.getResidentSize();
+
+    // only the cell of the camera fits
+    grid.setRadius(1, 1);
+    grid.setMemoryBudget(chunkSize);
+    grid.update(1.0f, 1.0f);
+    grid.finishLoading();
+    EXPECT_TRUE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{1, 0}));
+    EXPECT_EQ(grid.getResidentSize(), chunkSize);
+
+    // closer cells push out the ones further away
+    grid.update(11.0f, 1.0f);
+    grid.finishLoading();
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_TRUE(grid.isLoaded(Engine::CellCoord{1, 0}));
+
+    EXPECT_THROW(grid.setRadius(2, 1), const char *);
+    EXPECT_THROW(grid.track(registry.addEntity()), const char *);
+}
+
+TEST(ECS_WORLD_GRID_TEST, reused_ids_are_tracked)
+{
+    std::filesystem::path directory{gridDirectory()};
+    Engine::Registry registry{};
+    TestGrid grid{registry, directory, 10.0f, locate, 1024};
+
+    unsigned int removed = registry.addEntity();
+    registry.createComponent<GridPosition>(removed, GridPosition{1.0f, 1.0f});
+    grid.track(removed);
+    registry.removeEntity(removed);
+
+    // the new entity gets the id of the removed one and lands in the same cell
+    unsigned int entity = registry.addEntity();
+    ASSERT_EQ(entity, removed);
+    registry.createComponent<GridPosition>(entity, GridPosition{2.0f, 2.0f});
+    registry.createComponent<int>(entity, 7);
+    grid.track(entity);
+
+    const std::vector<Engine::EntityHandle> &tracked = grid.getEntities(Engine::CellCoord{0, 0});
+    EXPECT_NE(std::find(tracked.begin(), tracked.end(), registry.getHandle(entity)), tracked.end());
+
+    // so it is streamed out and back in with its cell
+    grid.update(55.0f, 1.0f);
+    grid.finishLoading();
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_TRUE(registry.getEntities().empty());
+
+    grid.update(1.0f, 1.0f);
+    grid.finishLoading();
+    ASSERT_EQ(registry.getEntities().size(), 1u);
+    EXPECT_EQ(*registry.getComponent<int>(registry.getEntities().front()), 7);
+}
+
+TEST(ECS_WORLD_GRID_TEST, failed_loads_leave_the_cell_unloaded)
+{
+    std::filesystem::path directory{gridDirectory()};
+    Engine::Registry registry{};
+
+    std::vector<unsigned int> entities = registry.addEntities(2);
+    registry.createComponent<GridPosition>(entities[0], GridPosition{1.0f, 1.0f});
+    registry.createComponent<GridPosition>(entities[1], GridPosition{55.0f, 1.0f});
+    registry.createComponent<int>(entities[1], 3);
+    {
+        TestGrid grid{registry, directory, 10.0f, locate, 1024};
+        grid.partition(entities);
+    }
+
+    // the grid knows the cell but its chunk is gone
+    TestGrid grid{registry, directory, 10.0f, locate, 1024};
+    std::filesystem::remove(directory / "cell_0_0.chunk");
+    grid.update(1.0f, 1.0f);
+    EXPECT_THROW(grid.finishLoading(), const char *);
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{0, 0}));
+    EXPECT_EQ(grid.getResidentSize(), 0u);
+
+    // the grid keeps streaming the other cells
+    grid.update(55.0f, 1.0f);
+    grid.finishLoading();
+    EXPECT_TRUE(grid.isLoaded(Engine::CellCoord{5, 0}));
+    ASSERT_EQ(registry.getEntities().size(), 1u);
+    EXPECT_EQ(*registry.getComponent<int>(registry.getEntities().front()), 3);
+
+    // the missing chunk fails again when it is needed again instead of breaking the grid
+    grid.update(1.0f, 1.0f);
+    EXPECT_THROW(grid.finishLoading(), const char *);
+    grid.update(1.0f, 1.0f);
+    EXPECT_FALSE(grid.isLoaded(Engine::CellCoord{0, 0}));
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <Core/Systems/Scheduler/scheduler.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Engine::Systems::Reads;
+using Engine::Systems::Writes;
+
+TEST(SCHEDULER_TEST, conflicting_systems_keep_their_order)
+{
+    Engine::Registry registry{};
+    unsigned int entity = registry.addEntity();
+    registry.createComponent<int>(entity, 1);
+
+    Engine::Systems::Scheduler scheduler{registry, 2};
+
+    scheduler.addSystem(
+        "double", Reads<>{}, Writes<int>{}, [](Engine::Registry &r) { r.each<int>([](int &i) { i *= 2; }); });
+    scheduler.addSystem(
+        "add", Reads<>{}, Writes<int>{}, [](Engine::Registry &r) { r.each<int>([](int &i) { i += 3; }); });
+    int read{0};
+    scheduler.addSystem(
+        "read", Reads<int>{}, Writes<>{}, [&](Engine::Registry &r) { read = *r.getComponent<int>(entity); });
+
+    for (int i = 0; i < 10; ++i)
+    {
+        *registry.getComponent<int>(entity) = 1;
+        scheduler.run();
+        EXPECT_EQ(read, 5);
+    }
+}
+
+TEST(SCHEDULER_TEST, independent_systems_run_in_parallel)
+{
+    Engine::Registry registry{};
+    Engine::Systems::Scheduler scheduler{registry, 1};
+
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    auto system = [&](Engine::Registry &)
+    {
+        ++running;
+        auto start = std::chrono::steady_clock::now();
+        // wait for the other system to start as well
+        while (running < 2 && std::chrono::steady_clock::now() - start < std::chrono::seconds{2})
+        {
+            std::this_thread::yield();
+        }
+        if (running == 2)
+        {
+            overlapped = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    };
+
+    scheduler.addSystem("a", Reads<int>{}, Writes<float>{}, system);
+    scheduler.addSystem("b", Reads<int>{}, Writes<double>{}, system);
+    scheduler.run();
+
+    EXPECT_TRUE(overlapped);
+
+    const Engine::Systems::FrameReport &report = scheduler.getReport();
+    ASSERT_EQ(report.systems.size(), 2);
+    EXPECT_EQ(report.systems[0].name, "a");
+    EXPECT_NE(report.systems[0].thread, report.systems[1].thread);
+    EXPECT_GT(report.parallelism(), 1.0);
+}
+
+TEST(SCHEDULER_TEST, main_thread_systems)
+{
+    Engine::Registry registry{};
+    Engine::Systems::Scheduler scheduler{registry, 2};
+
+    std::vector<std::thread::id> threads(4);
+    for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+        scheduler.addSystem(
+            "main " + std::to_string(i),
+            Reads<>{},
+            Writes<>{},
+            [&, i](Engine::Registry &) { threads[i] = std::this_thread::get_id(); },
+            true);
+    }
+    scheduler.run();
+
+    for (std::thread::id thread : threads)
+    {
+        EXPECT_EQ(thread, std::this_thread::get_id());
+    }
+}
+
+TEST(SCHEDULER_TEST, errors_are_rethrown)
+{
+    Engine::Registry registry{};
+    Engine::Systems::Scheduler scheduler{registry, 1};
+
+    bool ranAfterError{false};
+    scheduler.addSystem("throws", Reads<>{}, Writes<int>{}, [](Engine::Registry &) { throw "system failed"; });
+    scheduler.addSystem("after", Reads<int>{}, Writes<>{}, [&](Engine::Registry &) { ranAfterError = true; });
+
+    EXPECT_ANY_THROW(scheduler.run());
+    EXPECT_TRUE(ranAfterError);
+}
+
+TEST(SCHEDULER_TEST, command_buffers_are_submitted_after_the_frame)
+{
+    Engine::Registry registry{};
+    Engine::Systems::Scheduler scheduler{registry, 2};
+
+    unsigned int seen{0};
+    scheduler.addSystem("spawn",
+                        Reads<>{},
+                        Writes<>{},
+                        [&](Engine::Registry &r, Engine::CommandBuffer &commands)
+                        {
+                            seen = r.getEntities().size();
+                            commands.createComponent<int>(commands.addEntity(), 1);
+                        });
+
+    scheduler.run();
+    EXPECT_EQ(seen, 0u);
+    EXPECT_EQ(registry.getEntities().size(), 1u);
+
+    scheduler.run();
+    EXPECT_EQ(seen, 1u);
+    EXPECT_EQ(registry.getEntities().size(), 2u);
+}
+
+TEST(SCHEDULER_TEST, tables_are_created_before_the_frame)
+{
+    Engine::Registry registry{};
+    Engine::Systems::Scheduler scheduler{registry, 1};
+
+    scheduler.addSystem("reads", Reads<double>{}, Writes<char>{}, [](Engine::Registry &) {});
+    scheduler.run();
+
+    // both tables show up in the stats although no component was ever added
+    unsigned int numTables{0};
+    for (const Engine::ComponentTableStats &table : registry.stats().tables)
+    {
+        numTables += table.name == "double" || table.name == "char";
+    }
+    EXPECT_EQ(numTables, 2u);
+}
+
+#ifndef NDEBUG
+TEST(SCHEDULER_TEST, undeclared_access_throws_in_debug_builds)
+{
+    Engine::Registry registry{};
+    unsigned int entity = registry.addEntity();
+    registry.createComponent<int>(entity, 1);
+    Engine::Systems::Scheduler scheduler{registry, 1};
+
+    scheduler.addSystem(
+        "undeclared", Reads<float>{}, Writes<>{}, [&](Engine::Registry &r) { r.getComponent<int>(entity); });
+    EXPECT_THROW(scheduler.run(), const char *);
+
+    // the check is only active while systems run
+    EXPECT_EQ(*registry.getComponent<int>(entity), 1);
+}
+#endif
\ No newline at end of file